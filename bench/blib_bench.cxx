@@ -0,0 +1,1171 @@
+/*****************************************************************************/
+/*** Software: AMOS v0.01 (c)1998 All Rights Reserved by Bradley B. Custer ***/
+/*****************************************************************************/
+
+// File    : blib_bench.cxx
+// Purpose : benchmark of the blib containers against the comparable STL ones,
+//           dllist against std::list, std::vector and std::deque, and
+//           udllist, the unrolled list, against dllist, and
+//           HashTable against std::unordered_map, for insert, erase,
+//           iterate, lookup, sort and memory, at sizes 10, 100, .. max
+// Build   : g++ -std=c++11 -O2 -I../blib blib_bench.cxx ../blib/thread.cxx ../blib/dbfile.cxx -lpthread -o blib_bench
+// Useage  : blib_bench [max size] [suite ..]
+//           max size is 1000000 unless given (10000000 for the full run),
+//           suites are list, pool, udll, hash, sort, view, load,
+//           snapshot, grow and hashfn, all unless given
+// Output  : CSV on stdout, one row per container, operation and size,
+//             suite,container,op,size,ns_per_elem,allocs_per_elem,bytes_per_elem
+//           ns_per_elem and allocs_per_elem are per element the operation
+//           touched, bytes_per_elem is only on the memory rows, the bytes
+//           allocated for a container of that size, over its size,
+//           counting the values, which a dllist keeps apart from its nodes
+//           the grow suite's insert_max rows are the slowest single
+//           add_to_table() of a rep, in ns, not a mean, the least of
+//           the reps', so a stall of the machine's isn't counted
+//           the pool suite's _misses rows are not times, but hardware
+//           cache misses per element, only where the kernel gives a
+//           counter, none in most VMs, or with perf_event_paranoid > 2
+//           the hashfn suite's spread rows are not times, but a hash's
+//           sum over the buckets of c(c+1)/2, for c keys in a bucket,
+//           over what a random hash gives, 1.00 is as even as random
+//
+// Update Log -
+//
+// 20261017 - Begun, with the list, hash, sort and view suites
+// 20261017 - added the load suite, HashTable against RHHashTable by load factor
+// 20261017 - added the grow suite, HashTable insert latency by set_incremental()
+// 20261017 - added the hashfn suite, the HashTable hash policies' speed and spread
+// 20261017 - added the pool suite, dllist's dllpool nodes against a new for each node
+// 20261017 - added the udll suite, udllist against dllist
+// 20261017 - the list suite pops dllist empty, and range-fors over it, which must find nothing
+// 20261017 - added the snapshot suite, snap_map() and snap_load() against a DBFile read
+// 20261017 - the sort suite times sort_by_key(), on the id sort(LT) compares
+
+
+#include <cstdio>         // for printf()
+#include <cstdlib>        // for malloc(), free(), atoi()
+#include <cstring>        // for strcmp()
+#include <chrono>         // for steady_clock
+#include <new>            // for std::bad_alloc
+#include <string>
+#include <vector>
+#include <list>
+#include <deque>
+#include <algorithm>      // for std::sort(), std::find()
+#include <unordered_map>
+#include "dll.h"          // for dllist, dllpool
+#include "udll.h"         // for udllist
+#include "dllview.h"      // for view()
+#include "hash.h"         // for HashTable
+#include "rhhash.h"       // for RHHashTable
+#include "snapshot.h"     // for snap_save(), snap_map(), snap_load()
+#include "dbfile.h"       // for DBFile
+
+#ifdef __linux__
+#include <unistd.h>              // for syscall(), read()
+#include <sys/syscall.h>         // for SYS_perf_event_open
+#include <linux/perf_event.h>    // for the cache miss counter
+#endif
+
+
+using namespace blib;
+
+
+// counting allocator, every operator new and delete of the program
+//  goes through these, so each operation's allocations can be counted
+//  a block is given 16 bytes ahead of it to keep its size, and they
+//  are kept out of line, so the compiler sees no pointer arithmetic
+//  on the objects it knows were newed
+#define  BENCH_NOINLINE  __attribute__((noinline))
+static ulong alloc_count = 0;   // blocks allocated
+static ulong alloc_live  = 0;   // bytes allocated and not yet freed
+
+BENCH_NOINLINE void *operator new(size_t n)
+{
+    char *p = (char *) malloc(n + 16);
+    if( !p ) throw std::bad_alloc();
+    *(size_t *) p = n;
+    alloc_count++;
+    alloc_live += n;
+    return p + 16;
+} // operator new()
+
+BENCH_NOINLINE void *operator new(size_t n, const std::nothrow_t &) throw()
+{
+    char *p = (char *) malloc(n + 16);
+    if( !p ) return 0;
+    *(size_t *) p = n;
+    alloc_count++;
+    alloc_live += n;
+    return p + 16;
+} // operator new(nothrow)
+
+BENCH_NOINLINE void operator delete(void *v) throw()
+{
+    if( !v ) return;
+    char *p = (char *) v - 16;
+    alloc_live -= *(size_t *) p;
+    free(p);
+} // operator delete()
+
+void operator delete(void *v, const std::nothrow_t &) throw()
+{
+    operator delete(v);
+} // operator delete(nothrow)
+
+
+// Struct  : struct Item
+// Purpose : the value every container holds, an id and a key of it
+struct Item
+{
+    uint id;
+    char name[24];
+
+    const char *key(void) const { return name; }    // for HashTable
+    bool operator<(const Item &a) const  { return id < a.id; }
+    bool operator==(const Item &a) const { return id == a.id; }
+    bool dll_lessthan(const Item *a) const { return id < a->id; }
+}; // struct Item
+
+
+// less-thans for the sort suite, one to be called through a pointer
+//  and one a functor, which the sort can inline
+static bool item_lessthan(const Item *a, const Item *b) { return a->id < b->id; }
+struct ItemLess
+{
+    bool operator()(const Item *a, const Item *b) const { return a->id < b->id; }
+}; // struct ItemLess
+
+
+static volatile ulong sink;     // results go here, so no loop is optimized away
+
+
+// Function : double seconds(void)
+// Purpose  : a steady clock in seconds
+static double seconds(void)
+{
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+} // seconds()
+
+
+// Function : long cache_misses(void)
+// Purpose  : this thread's hardware cache misses so far
+// Returns  : -1 if the kernel gives no counter
+static long cache_misses(void)
+{
+#ifdef __linux__
+    static int fd = -2;   // -2 until tried, -1 if there is no counter
+    if( fd == -2 )
+    {
+        perf_event_attr a;
+        memset(&a, 0, sizeof(a));
+        a.size           = sizeof(a);
+        a.type           = PERF_TYPE_HARDWARE;
+        a.config         = PERF_COUNT_HW_CACHE_MISSES;
+        a.exclude_kernel = 1;
+        a.exclude_hv     = 1;
+        fd = syscall(SYS_perf_event_open, &a, 0, -1, -1, 0);
+        if( fd < 0 ) fd = -1;
+    } // if
+
+    long long count;
+    if( fd >= 0 && read(fd, &count, sizeof(count)) == sizeof(count) )
+        return (long) count;
+#endif
+    return -1;
+} // cache_misses()
+
+
+// Struct  : struct Tally
+// Purpose : time and allocations spent on one operation, over every rep
+struct Tally
+{
+    double secs;
+    ulong  allocs;
+    ulong  elems;      // elements the operation touched
+    double t0;         // set by begin()
+    ulong  a0;
+
+    Tally(void) : secs(0), allocs(0), elems(0), t0(0), a0(0) {}
+    void begin(void) { a0 = alloc_count; t0 = seconds(); }
+    void end(ulong n) { secs += seconds() - t0; allocs += alloc_count - a0; elems += n; }
+}; // struct Tally
+
+
+// Function : void row(suite, container, op, size, const Tally &)
+// Purpose  : print one CSV row of a tally
+static void row(const char *suite, const char *container, const char *op, uint n, const Tally &t)
+{
+    if( !t.elems ) return;
+    printf("%s,%s,%s,%u,%.2f,%.3f,\n", suite, container, op, n,
+           t.secs * 1e9 / t.elems, (double) t.allocs / t.elems);
+} // row()
+
+
+// Function : void memrow(suite, container, size, bytes)
+// Purpose  : print one CSV memory row
+static void memrow(const char *suite, const char *container, uint n, ulong bytes)
+{
+    printf("%s,%s,memory,%u,,,%.1f\n", suite, container, n, (double) bytes / n);
+} // memrow()
+
+
+// Function : uint reps_for(uint n)
+// Purpose  : how many times to run a size, so a run touches about 1M elements
+static uint reps_for(uint n)
+{
+    return n < 1000000 ? 1000000 / n : 1;
+} // reps_for()
+
+
+// Function : uint probes_for(uint n)
+// Purpose  : linear searches to time in a container of n, so each rep is
+//            about n * 1000 steps at most
+static uint probes_for(uint n)
+{
+    if( n <= 1000 ) return n;
+    return n >= 1000000 ? 1 : 1000000 / n;
+} // probes_for()
+
+
+// Function : void make_items(std::vector<Item> &items, uint n)
+// Purpose  : n items, with ids 0..n-1 in a random order, and keys like
+//            "host.metric.N", which share a long prefix
+static void make_items(std::vector<Item> &items, uint n)
+{
+    items.resize(n);
+    for(uint i = 0; i < n; i++)
+        items[i].id = i;
+    uint seed = 2463534242u;
+    for(uint i = n; i > 1; i--)
+    {   // Fisher-Yates, by xorshift
+        seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+        std::swap(items[i - 1].id, items[seed % i].id);
+    } // for
+    for(uint i = 0; i < n; i++)
+        snprintf(items[i].name, sizeof(items[i].name), "host.metric.%u", items[i].id);
+} // make_items()
+
+
+// the STL sequences' erase half and sort, as each best does them
+static void erase_half(std::list<Item> &c)
+{
+    uint k = 0;
+    for(std::list<Item>::iterator i = c.begin(); i != c.end(); k++)
+        if( k & 1 ) i = c.erase(i); else ++i;
+} // erase_half()
+
+template <class C> static void erase_half(C &c)
+{
+    uint k = 0;
+    c.erase(std::remove_if(c.begin(), c.end(),
+                           [&k](const Item &) { return (k++ & 1) != 0; }), c.end());
+} // erase_half()
+
+static void sort_all(std::list<Item> &c) { c.sort(); }
+template <class C> static void sort_all(C &c) { std::sort(c.begin(), c.end()); }
+
+
+// Template : void stl_sequence(const char *name, const std::vector<Item> &items)
+// Purpose  : the list suite for one STL sequence, which holds copies of the items
+template <class C>
+  void stl_sequence(const char *name, const std::vector<Item> &items)
+{
+    uint n = items.size(), reps = reps_for(n), probes = probes_for(n);
+    Tally insert, iterate, lookup, sort, erase;
+    ulong bytes = 0;
+
+    for(uint r = 0; r < reps; r++)
+    {
+        ulong live = alloc_live;
+        insert.begin();
+        C c;
+        for(uint i = 0; i < n; i++)
+            c.push_back(items[i]);
+        insert.end(n);
+        bytes = alloc_live - live;
+
+        iterate.begin();
+        ulong sum = 0;
+        for(typename C::const_iterator i = c.begin(); i != c.end(); ++i)
+            sum += i->id;
+        iterate.end(n);
+
+        lookup.begin();
+        for(uint p = 0; p < probes; p++)
+            sum += std::find(c.begin(), c.end(), items[(ulong) p * n / probes]) != c.end();
+        lookup.end(probes);
+
+        sort.begin();
+        sort_all(c);
+        sort.end(n);
+
+        erase.begin();
+        erase_half(c);
+        erase.end(n / 2);
+        sink = sum + c.size();
+    } // for
+
+    row("list", name, "insert", n, insert);
+    row("list", name, "iterate", n, iterate);
+    row("list", name, "lookup", n, lookup);
+    row("list", name, "sort", n, sort);
+    row("list", name, "erase", n, erase);
+    memrow("list", name, n, bytes);
+} // template stl_sequence()
+
+
+// Function : void blib_dllist(std::vector<Item> &items)
+// Purpose  : the list suite for dllist, which holds pointers to the items
+static void blib_dllist(std::vector<Item> &items)
+{
+    uint n = items.size(), reps = reps_for(n), probes = probes_for(n);
+    Tally insert, iterate, lookup, sort, erase, pop;
+    ulong bytes = 0;
+
+    for(uint r = 0; r < reps; r++)
+    {
+        dllpool<Item>::pool().release();  // so each rep allocates its nodes, as the STL's do
+        ulong live = alloc_live;
+        insert.begin();
+        dllist<Item> c;
+        for(uint i = 0; i < n; i++)
+            c.add(&items[i]);
+        insert.end(n);
+        bytes = alloc_live - live + n * sizeof(Item);
+
+        iterate.begin();
+        ulong sum = 0;
+        for(cdllit<Item> i(c); !i.finished(); ++i)
+            sum += i()->id;
+        iterate.end(n);
+
+        lookup.begin();
+        for(uint p = 0; p < probes; p++)
+            sum += c.ref_in_list(items[(ulong) p * n / probes]) != 0;
+        lookup.end(probes);
+
+        sort.begin();
+        c.sort();
+        sort.end(n);
+
+        erase.begin();
+        dllit<Item> i(c);
+        for(uint k = 0; k < n; k++)
+            if( k & 1 ) i.remove(); else ++i;
+        erase.end(n / 2);
+        sink = sum + c.size();
+
+        uint left = c.size();
+        pop.begin();
+        while( c.pop() ) ;
+        pop.end(left);
+        for(Item *v : c)  // an emptied list's begin() must be its end()
+        {   fprintf(stderr, "blib_bench: range-for over an emptied dllist reached %u\n", v->id);
+            exit(1);
+        } // for
+    } // for
+
+    row("list", "dllist", "insert", n, insert);
+    row("list", "dllist", "iterate", n, iterate);
+    row("list", "dllist", "lookup", n, lookup);
+    row("list", "dllist", "sort", n, sort);
+    row("list", "dllist", "erase", n, erase);
+    row("list", "dllist", "pop", n / 2, pop);
+    memrow("list", "dllist", n, bytes);
+} // blib_dllist()
+
+
+// Function : ulong list_sum(const dllist<Item> &)
+// Purpose  : the sum of the ids of a list, walking it in order
+static ulong list_sum(const dllist<Item> &c)
+{
+    ulong s = 0;
+    for(cdllit<Item> i(c); !i.finished(); ++i)
+        s += i()->id;
+    return s;
+} // list_sum()
+
+
+// Struct  : struct newnode
+// Purpose : a list node as dllist allocated them before dllpool, each by
+//           its own new, for the pool suite to compare against
+struct newnode
+{
+    Item    *value;
+    newnode *next;
+    newnode *prior;
+}; // struct newnode
+
+
+// Struct  : struct newlist
+// Purpose : dllist's add() and purge() as they were before dllpool, on
+//           newnodes, the same ring, a new and a delete for each node
+struct newlist
+{
+    newnode *head;
+    uint     length;
+
+    newlist(void) : head(0), length(0) {}
+    ~newlist(void) { purge(); }
+
+    void add(Item *v)
+    {
+        newnode *tmp = new newnode;
+        tmp->value = v;
+        if( !length )
+            head = tmp->next = tmp;
+        else
+        {
+            tmp->prior        = head->prior;
+            head->prior->next = tmp;
+            tmp->next         = head;
+        } // else
+        head->prior = tmp;
+        length++;
+    } // add()
+
+    void purge(void)
+    {
+        newnode *tmp = head;
+        while( length-- )
+        {
+            newnode *next = tmp->next;
+            delete tmp;
+            tmp = next;
+        } // while
+        head = 0; length = 0;
+    } // purge()
+
+    ulong sum(void) const
+    {
+        ulong s = 0;
+        newnode *tmp = head;
+        for(uint i = 0; i < length; i++, tmp = tmp->next)
+            s += tmp->value->id;
+        return s;
+    } // sum()
+}; // struct newlist
+
+
+// Struct  : struct MissTally
+// Purpose : a Tally that also counts the cache misses of the operation
+struct MissTally : Tally
+{
+    long misses;
+    long m0;
+
+    MissTally(void) : misses(0), m0(0) {}
+    void begin(void) { m0 = cache_misses(); Tally::begin(); }
+    void end(ulong n) { Tally::end(n); misses += cache_misses() - m0; }
+}; // struct MissTally
+
+
+// Function : void pool_rows(const char *container, const char *op, uint n, const MissTally &)
+// Purpose  : the row of an operation, and its _misses row if there is a counter
+static void pool_rows(const char *container, const char *op, uint n, const MissTally &t)
+{
+    row("pool", container, op, n, t);
+    if( cache_misses() < 0 || !t.elems ) return;
+    printf("pool,%s,%s_misses,%u,%.3f,,\n", container, op, n, (double) t.misses / t.elems);
+} // pool_rows()
+
+
+static ulong list_sum(const newlist &c) { return c.sum(); }
+
+
+// Template : void pool_list(const char *name, std::vector<Item> &items)
+// Purpose  : the pool suite for a list L, of dllist or newlist, n adds, a
+//            walk summing the ids and a purge(), then again with a block
+//            of a node's size newed between each add, as a program's
+//            other allocations come between its list's, so the nodes of
+//            a newlist are spread over twice the memory, and the walk
+//            misses the cache more
+template <class L>
+  void pool_list(const char *name, std::vector<Item> &items)
+{
+    uint n = items.size(), reps = reps_for(n);
+    MissTally add, walk, purge, add_mixed, walk_mixed, purge_mixed;
+    std::vector<char *> other(n);
+
+    for(uint r = 0; r < reps; r++)
+    {
+        L c;
+        add.begin();
+        for(uint i = 0; i < n; i++)
+            c.add(&items[i]);
+        add.end(n);
+        walk.begin();
+        sink = list_sum(c);
+        walk.end(n);
+        purge.begin();
+        c.purge();
+        purge.end(n);
+
+        add_mixed.begin();
+        for(uint i = 0; i < n; i++)
+        {
+            other[i] = new char[sizeof(newnode)];
+            c.add(&items[i]);
+        } // for
+        add_mixed.end(n);
+        walk_mixed.begin();
+        sink = list_sum(c);
+        walk_mixed.end(n);
+        purge_mixed.begin();
+        c.purge();
+        purge_mixed.end(n);
+        for(uint i = 0; i < n; i++)
+            delete [] other[i];
+    } // for
+
+    pool_rows(name, "add", n, add);
+    pool_rows(name, "iterate", n, walk);
+    pool_rows(name, "purge", n, purge);
+    pool_rows(name, "add_mixed", n, add_mixed);
+    pool_rows(name, "iterate_mixed", n, walk_mixed);
+    pool_rows(name, "purge_mixed", n, purge_mixed);
+} // template pool_list()
+
+
+// Function : void pool_suite(uint n)
+// Purpose  : dllist, whose nodes come from dllpool, against newlist,
+//            a new for each node, as dllist was before
+static void pool_suite(uint n)
+{
+    std::vector<Item> items;
+    make_items(items, n);
+    pool_list< dllist<Item> >("dllist", items);
+    pool_list< newlist >("dllist(new)", items);
+} // pool_suite()
+
+
+// Template : void unrolled_list(const char *name, std::vector<Item> &items)
+// Purpose  : the udll suite for a list L, of dllist or udllist, n adds,
+//            a walk summing the ids, up to 1000 inserts by add_num() at
+//            the middle, and at positions spread over the list, and memory
+// Note     : add_num() at the middle starts where the last one left
+//            off, in either list, so after the first walk to the middle
+//            it is O(1), the spread ones walk from the nearest known
+//            place, a node at a time in a dllist and a chunk at a time
+//            in a udllist
+template <class L>
+  void unrolled_list(const char *name, std::vector<Item> &items)
+{
+    uint n = items.size(), reps = reps_for(n), probes = probes_for(n);
+    uint mids = n < 1000 ? n : 1000;
+    Tally add, walk, mid, spread;
+    ulong bytes = 0;
+
+    for(uint r = 0; r < reps; r++)
+    {
+        dllpool<Item>::pool().release();  // so a dllist allocates its nodes each rep
+        ulong live = alloc_live;
+        L c;
+        add.begin();
+        for(uint i = 0; i < n; i++)
+            c.add(&items[i]);
+        add.end(n);
+        bytes = alloc_live - live + n * sizeof(Item);
+
+        walk.begin();
+        ulong sum = 0;
+        for(typename L::citerator i(c); !i.finished(); ++i)
+            sum += i()->id;
+        walk.end(n);
+
+        mid.begin();
+        for(uint p = 0; p < mids; p++)
+            c.add_num(&items[p], c.size() / 2);
+        mid.end(mids);
+
+        uint seed = 2463534242u;
+        spread.begin();
+        for(uint p = 0; p < probes; p++)
+        {
+            seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+            c.add_num(&items[p], seed % c.size());
+        } // for
+        spread.end(probes);
+        sink = sum + c.size();
+    } // for
+
+    row("udll", name, "add", n, add);
+    row("udll", name, "iterate", n, walk);
+    row("udll", name, "insert_mid", n, mid);
+    row("udll", name, "insert_spread", n, spread);
+    memrow("udll", name, n, bytes);
+} // template unrolled_list()
+
+
+// Function : void udll_suite(uint n)
+// Purpose  : udllist, many value pointers to a chunk, against dllist
+static void udll_suite(uint n)
+{
+    std::vector<Item> items;
+    make_items(items, n);
+    unrolled_list< udllist<Item> >("udllist", items);
+    unrolled_list< dllist<Item> >("dllist", items);
+} // udll_suite()
+
+
+// Function : void list_suite(uint n)
+// Purpose  : dllist against std::list, std::vector and std::deque
+static void list_suite(uint n)
+{
+    std::vector<Item> items;
+    make_items(items, n);
+    blib_dllist(items);
+    stl_sequence< std::list<Item> >("std::list", items);
+    stl_sequence< std::vector<Item> >("std::vector", items);
+    stl_sequence< std::deque<Item> >("std::deque", items);
+} // list_suite()
+
+
+// Function : void hash_suite(uint n)
+// Purpose  : HashTable against std::unordered_map<std::string, Item>,
+//            each sized for n first, then looked up by every key,
+//            by as many keys not in it, iterated, and emptied by key
+static void hash_suite(uint n)
+{
+    std::vector<Item> items;
+    make_items(items, n);
+    std::vector<std::string> keys(n), misses(n);
+    for(uint i = 0; i < n; i++)
+    {
+        keys[i]   = items[i].name;
+        misses[i] = keys[i] + ".x";
+    } // for
+    uint reps = reps_for(n);
+
+    {   // HashTable, of pointers to the items
+        Tally insert, hit, miss, iterate, erase;
+        ulong bytes = 0;
+        for(uint r = 0; r < reps; r++)
+        {
+            ulong live = alloc_live;
+            insert.begin();
+            HashTable<Item> t(n);
+            for(uint i = 0; i < n; i++)
+                t.add_to_table(&items[i]);
+            insert.end(n);
+            bytes = alloc_live - live + n * sizeof(Item);
+
+            ulong sum = 0;
+            hit.begin();
+            for(uint i = 0; i < n; i++)
+                sum += t.lookup(keys[i].c_str()) != 0;
+            hit.end(n);
+            miss.begin();
+            for(uint i = 0; i < n; i++)
+                sum += t.lookup(misses[i].c_str()) != 0;
+            miss.end(n);
+
+            iterate.begin();
+            for(chashit<Item> i(t); ++i;)
+                sum += i()->id;
+            iterate.end(n);
+
+            erase.begin();
+            for(uint i = 0; i < n; i++)
+                sum += t.remove(keys[i].c_str()) != 0;
+            erase.end(n);
+            sink = sum;
+        } // for
+        row("hash", "HashTable", "insert", n, insert);
+        row("hash", "HashTable", "lookup", n, hit);
+        row("hash", "HashTable", "lookup_miss", n, miss);
+        row("hash", "HashTable", "iterate", n, iterate);
+        row("hash", "HashTable", "erase", n, erase);
+        memrow("hash", "HashTable", n, bytes);
+    } // HashTable
+
+    {   // std::unordered_map, of copies of the items
+        typedef std::unordered_map<std::string, Item> Map;
+        Tally insert, hit, miss, iterate, erase;
+        ulong bytes = 0;
+        for(uint r = 0; r < reps; r++)
+        {
+            ulong live = alloc_live;
+            insert.begin();
+            Map t;
+            t.reserve(n);
+            for(uint i = 0; i < n; i++)
+                t.emplace(keys[i], items[i]);
+            insert.end(n);
+            bytes = alloc_live - live;
+
+            ulong sum = 0;
+            hit.begin();
+            for(uint i = 0; i < n; i++)
+                sum += t.find(keys[i]) != t.end();
+            hit.end(n);
+            miss.begin();
+            for(uint i = 0; i < n; i++)
+                sum += t.find(misses[i]) != t.end();
+            miss.end(n);
+
+            iterate.begin();
+            for(Map::const_iterator i = t.begin(); i != t.end(); ++i)
+                sum += i->second.id;
+            iterate.end(n);
+
+            erase.begin();
+            for(uint i = 0; i < n; i++)
+                sum += t.erase(keys[i]);
+            erase.end(n);
+            sink = sum;
+        } // for
+        row("hash", "std::unordered_map", "insert", n, insert);
+        row("hash", "std::unordered_map", "lookup", n, hit);
+        row("hash", "std::unordered_map", "lookup_miss", n, miss);
+        row("hash", "std::unordered_map", "iterate", n, iterate);
+        row("hash", "std::unordered_map", "erase", n, erase);
+        memrow("hash", "std::unordered_map", n, bytes);
+    } // std::unordered_map
+} // hash_suite()
+
+
+// Function : void sort_suite(uint n)
+// Purpose  : dllist's sorts, by each kind of less-than it takes, the
+//            function pointer sort(bool (*)()) against the inlinable
+//            sort(LT), and sort_by_key() on the id sort(LT) compares,
+//            and std::sort() of a vector of the same pointers
+static void sort_suite(uint n)
+{
+    std::vector<Item> items;
+    make_items(items, n);
+    uint reps = reps_for(n);
+    Tally opr, dll, fnptr, functor, bykey, radix, vfnptr, vfunctor;
+
+    for(uint r = 0; r < reps; r++)
+    {
+        dllist<Item> a, b, c, d, e, f;
+        std::vector<Item *> v, w;
+        for(uint i = 0; i < n; i++)
+        {
+            a.add(&items[i]); b.add(&items[i]); c.add(&items[i]);
+            d.add(&items[i]); e.add(&items[i]); f.add(&items[i]);
+            v.push_back(&items[i]); w.push_back(&items[i]);
+        } // for
+
+        opr.begin();      a.sort();                         opr.end(n);
+        dll.begin();      b.sort_dll();                     dll.end(n);
+        fnptr.begin();    c.sort(item_lessthan);            fnptr.end(n);
+        functor.begin();  d.sort(ItemLess());               functor.end(n);
+        bykey.begin();    f.sort_by_key([](const Item *i) { return i->id; });  bykey.end(n);
+        radix.begin();    e.radix_sort([](const Item *i) { return i->id; });  radix.end(n);
+        vfnptr.begin();   std::sort(v.begin(), v.end(), item_lessthan);  vfnptr.end(n);
+        vfunctor.begin(); std::sort(w.begin(), w.end(), ItemLess());     vfunctor.end(n);
+        sink = a.first()->id + v[0]->id;
+    } // for
+
+    row("sort", "dllist", "sort(operator<)", n, opr);
+    row("sort", "dllist", "sort_dll()", n, dll);
+    row("sort", "dllist", "sort(fnptr)", n, fnptr);
+    row("sort", "dllist", "sort(LT)", n, functor);
+    row("sort", "dllist", "sort_by_key()", n, bykey);
+    row("sort", "dllist", "radix_sort()", n, radix);
+    row("sort", "std::vector<T*>", "std::sort(fnptr)", n, vfnptr);
+    row("sort", "std::vector<T*>", "std::sort(LT)", n, vfunctor);
+} // sort_suite()
+
+
+// Function : void view_suite(uint n)
+// Purpose  : the sum of twice the ids of the first half of the even
+//            items, by a lazy view pipeline, and by filtering into a
+//            dllist first, as was done before dllview
+static void view_suite(uint n)
+{
+    std::vector<Item> items;
+    make_items(items, n);
+    dllist<Item> list;
+    for(uint i = 0; i < n; i++)
+        list.add(&items[i]);
+    uint reps = reps_for(n);
+    Tally lazy, eager;
+
+    for(uint r = 0; r < reps; r++)
+    {
+        ulong sum = 0;
+        lazy.begin();
+        view(list).filter([](const Item *i) { return !(i->id & 1); })
+                  .transform([](const Item *i) { return (ulong) i->id * 2; })
+                  .take(n / 4)
+                  .for_each([&sum](ulong x) { sum += x; });
+        lazy.end(n);
+
+        eager.begin();
+        dllist<Item> evens;
+        for(cdllit<Item> i(list); !i.finished(); ++i)
+            if( !(i()->id & 1) ) evens.add(i());
+        uint k = 0;
+        for(cdllit<Item> i(evens); !i.finished() && k < n / 4; ++i, k++)
+            sum += (ulong) i()->id * 2;
+        eager.end(n);
+        sink = sum;
+    } // for
+
+    row("view", "dllview", "filter_transform_take", n, lazy);
+    row("view", "dllist", "filter_transform_take", n, eager);
+} // view_suite()
+
+
+// Function : void hold_size(H &table)
+// Purpose  : keep a HashTable from growing past its load factor, so the
+//            load suite measures the load it asks for, a RHHashTable
+//            never holds more than RHHASH_MAX_LOAD
+static void hold_size(HashTable<Item> &table) { table.set_max_load(0); }
+static void hold_size(RHHashTable<Item> &) {}
+
+
+// Template : void table_load(const char *name, slots, items)
+// Purpose  : one row each of insert, lookup, lookup_miss and erase of a
+//            hash table H of the given slots, filled with items, so
+//            the load factor is items.size() / slots
+template <class H>
+  void table_load(const char *name, ulong slots, std::vector<Item> &items)
+{
+    uint n = items.size(), reps = reps_for(n);
+    std::vector<std::string> misses(n);
+    for(uint i = 0; i < n; i++)
+        misses[i] = std::string(items[i].name) + ".x";
+    Tally insert, hit, miss, erase;
+
+    for(uint r = 0; r < reps; r++)
+    {
+        H t(slots);
+        hold_size(t);
+        insert.begin();
+        for(uint i = 0; i < n; i++)
+            t.add_to_table(&items[i]);
+        insert.end(n);
+
+        ulong sum = 0;
+        hit.begin();
+        for(uint i = 0; i < n; i++)
+            sum += t.lookup(items[i].name) != 0;
+        hit.end(n);
+        miss.begin();
+        for(uint i = 0; i < n; i++)
+            sum += t.lookup(misses[i].c_str()) != 0;
+        miss.end(n);
+
+        erase.begin();
+        for(uint i = 0; i < n; i++)
+            sum += t.remove(items[i].name) != 0;
+        erase.end(n);
+        sink = sum;
+    } // for
+
+    row("load", name, "insert", n, insert);
+    row("load", name, "lookup", n, hit);
+    row("load", name, "lookup_miss", n, miss);
+    row("load", name, "erase", n, erase);
+} // template table_load()
+
+
+// Function : void load_suite(uint n)
+// Purpose  : the chained HashTable against the open addressing
+//            RHHashTable, each of the power of two slots at or above n,
+//            filled to 50, 75 and 90 percent, RHHashTable's most,
+//            and HashTable on to 200, 300 and 400 percent, which only it
+//            can hold, its collision lists 3 or more long at 300
+//            HashTable is given one slot less, an odd size, as it was
+//            when hashispell, which keeps only the last characters'
+//            bits in a power of two size, was its only hash
+static void load_suite(uint n)
+{
+    ulong slots = 8;
+    while( slots < n ) slots <<= 1;
+    static const uint loads[] = { 50, 75, 90, 200, 300, 400 };
+
+    for(uint l = 0; l < sizeof(loads) / sizeof(loads[0]); l++)
+    {
+        std::vector<Item> items;
+        make_items(items, slots * loads[l] / 100);
+        char name[40];
+        snprintf(name, sizeof(name), "HashTable@%u%%", loads[l]);
+        table_load< HashTable<Item> >(name, slots - 1, items);
+        if( loads[l] > RHHASH_MAX_LOAD ) continue;
+        snprintf(name, sizeof(name), "RHHashTable@%u%%", loads[l]);
+        table_load< RHHashTable<Item> >(name, slots, items);
+    } // for
+} // load_suite()
+
+
+// the files the snapshot suite writes, and reads back, and removes
+#define  BENCH_SNAPFILE  "/tmp/blib_bench.snp"
+#define  BENCH_DBFILE    "/tmp/blib_bench.db"
+
+
+// Function : void snapshot_suite(uint n)
+// Purpose  : loading a dllist of n items from a file, the same items
+//            snap_save()d, then snap_map()ped and snap_load()ed, against
+//            written as a DBFile, a group of each key with the id as its
+//            one field, then DBFile::read() and a new Item built of each
+//            record, as a program keeping its items in a DBFile must
+//            writing the files is not timed, opening them is
+static void snapshot_suite(uint n)
+{
+    std::vector<Item> items;
+    make_items(items, n);
+    uint reps = reps_for(n);
+
+    {   dllist<Item> l;
+        for(uint i = 0; i < n; i++)
+            l.add(&items[i]);
+        if( snap_save(l, BENCH_SNAPFILE) )
+        {
+            fprintf(stderr, "blib_bench: can't write %s\n", BENCH_SNAPFILE);
+            return;
+        } // if
+    }
+    FILE *f = fopen(BENCH_DBFILE, "w");
+    if( !f )
+    {
+        fprintf(stderr, "blib_bench: can't write %s\n", BENCH_DBFILE);
+        remove(BENCH_SNAPFILE);
+        return;
+    } // if
+    for(uint i = 0; i < n; i++)
+        fprintf(f, "[%s]\nid=%u\n", items[i].name, items[i].id);
+    fclose(f);
+
+    Tally map, load, db;
+    for(uint r = 0; r < reps; r++)
+    {
+        ulong sum = 0;
+        {   map.begin();
+            snapfile s(BENCH_SNAPFILE);
+            dllist<Item> l;
+            snap_map(l, s);
+            for(cdllit<Item> i(l); !i.finished(); ++i)
+                sum += i()->id;
+            map.end(n);
+        }
+        {   load.begin();
+            snapfile s(BENCH_SNAPFILE);
+            dllist<Item> l;
+            snap_load(l, s);
+            for(cdllit<Item> i(l); !i.finished(); ++i)
+                sum += i()->id;
+            load.end(n);
+            l.free_all();
+        }
+        {   db.begin();
+            DBFile d;
+            d.read(BENCH_DBFILE);
+            dllist<Item> l;
+            for(cdllit<DBRecord> i(d); !i.finished(); ++i)
+            {
+                Item *item = new Item;
+                item->id = i()->value;
+                snprintf(item->name, sizeof(item->name), "%s", i()->group.c_str());
+                l.add(item);
+            } // for
+            for(cdllit<Item> i(l); !i.finished(); ++i)
+                sum += i()->id;
+            db.end(n);
+            l.free_all();
+        }
+        sink = sum;
+    } // for
+    remove(BENCH_SNAPFILE);
+    remove(BENCH_DBFILE);
+
+    row("snapshot", "dllist", "snap_map", n, map);
+    row("snapshot", "dllist", "snap_load", n, load);
+    row("snapshot", "DBFile", "read+rebuild", n, db);
+} // snapshot_suite()
+
+
+// Function : void grow_suite(uint n)
+// Purpose  : n inserts into a HashTable grown from empty, resizing at
+//            once and set_incremental() to 1, 8 and 64 buckets a call,
+//            each timed alone, a mean insert row and the slowest one,
+//            at least 3 reps, a resize is slow every rep, a stall isn't
+static void grow_suite(uint n)
+{
+    static const uint steps[] = { 0, 1, 8, 64 };
+    std::vector<Item> items;
+    make_items(items, n);
+    uint reps = reps_for(n) < 3 ? 3 : reps_for(n);
+
+    for(uint s = 0; s < sizeof(steps) / sizeof(steps[0]); s++)
+    {
+        Tally insert;
+        double least = 0;
+        for(uint r = 0; r < reps; r++)
+        {
+            double worst = 0;
+            HashTable<Item> t;
+            t.set_incremental(steps[s]);
+            insert.begin();
+            for(uint i = 0; i < n; i++)
+            {
+                double t0 = seconds();
+                t.add_to_table(&items[i]);
+                double t1 = seconds() - t0;
+                if( t1 > worst ) worst = t1;
+            } // for
+            insert.end(n);
+            if( !r || worst < least ) least = worst;
+        } // for
+
+        char name[40];
+        snprintf(name, sizeof(name), "HashTable/step%u", steps[s]);
+        row("grow", name, "insert", n, insert);
+        printf("grow,%s,insert_max,%u,%.0f,,\n", name, n, least * 1e9);
+    } // for
+} // grow_suite()
+
+
+// Function : void make_keys(std::vector<std::string> &keys, const char *kind, uint n)
+// Purpose  : n distinct keys of a kind, "metric" the make_items() keys,
+//            "word" 4 to 12 random letters, with a number when they
+//            repeat, and "path" paths of 60 to 200 characters, which
+//            share their first 40
+static void make_keys(std::vector<std::string> &keys, const char *kind, uint n)
+{
+    keys.resize(n);
+    uint seed = 88675123u;
+    char buf[256];
+    for(uint i = 0; i < n; i++)
+    {
+        seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+        if( !strcmp(kind, "metric") )
+            snprintf(buf, sizeof(buf), "host.metric.%u", i);
+        else if( !strcmp(kind, "word") )
+        {
+            uint len = 4 + seed % 9, j = 0;
+            for(uint r = seed; j < len; j++, r = r * 1103515245u + 12345u)
+                buf[j] = 'a' + (r >> 16) % 26;
+            snprintf(buf + j, sizeof(buf) - j, "%u", i);
+        } // else if
+        else
+        {
+            uint len = 60 + seed % 141;
+            int  j = snprintf(buf, sizeof(buf), "/var/lib/amos/spool/archive/2026/10/17/%u", i);
+            for(; j < (int) len; j++)
+                buf[j] = 'a' + (seed >> (j % 24)) % 26;
+            buf[len] = 0;
+        } // else
+        keys[i] = buf;
+    } // for
+} // make_keys()
+
+
+// Template : void hash_keys(const char *name, const char *kind, H h, keys)
+// Purpose  : one hash row, the time of h(key) over the keys, and a spread
+//            row each for the next_prime() buckets HashTable would have,
+//            and for the power of two at or above the number of keys
+template <class H>
+  void hash_keys(const char *name, const char *kind, H h, const std::vector<std::string> &keys)
+{
+    uint n = keys.size(), reps = reps_for(n);
+    std::vector<ulong> hashes(n);
+    Tally t;
+
+    for(uint r = 0; r < reps; r++)
+    {
+        t.begin();
+        for(uint i = 0; i < n; i++)
+            hashes[i] = h(keys[i].c_str());
+        t.end(n);
+    } // for
+
+    char op[40];
+    snprintf(op, sizeof(op), "hash_%s", kind);
+    row("hashfn", name, op, n, t);
+
+    ulong sizes[2] = { HashTable<Item>::next_prime(n), 1 };
+    while( sizes[1] < n ) sizes[1] <<= 1;
+    for(int s = 0; s < 2; s++)
+    {
+        ulong m = sizes[s];
+        std::vector<uint> count(m);
+        double sum = 0;
+        for(uint i = 0; i < n; i++)
+            sum += ++count[ hashes[i] % m ];   // c(c+1)/2, a key at a time
+        double random = (double) n / (2.0 * m) * (n + 2.0 * m - 1);
+        snprintf(op, sizeof(op), "spread_%s_%s", kind, s ? "pow2" : "prime");
+        printf("hashfn,%s,%s,%u,%.3f,,\n", name, op, n, sum / random);
+    } // for
+} // template hash_keys()
+
+
+// Struct  : struct hashfnv
+// Purpose : RHHashTable's hash as a policy, to compare
+struct hashfnv
+{
+    ulong operator()(const char *s) const { return RHHashTable<Item>::getHashKey(s); }
+}; // struct hashfnv
+
+
+// Function : void hashfn_suite(uint n)
+// Purpose  : the HashTable hash policies, and RHHashTable's hash, over n
+//            keys of each make_keys() kind, their speed and spread
+static void hashfn_suite(uint n)
+{
+    static const char *kinds[] = { "metric", "word", "path" };
+    std::vector<std::string> keys;
+
+    for(uint k = 0; k < sizeof(kinds) / sizeof(kinds[0]); k++)
+    {
+        make_keys(keys, kinds[k], n);
+        hash_keys("hashispell", kinds[k], hashispell(), keys);
+        hash_keys("hashwy", kinds[k], hashwy(), keys);
+        hash_keys("hashwyfold", kinds[k], hashwyfold(), keys);
+        hash_keys("RHHashTable", kinds[k], hashfnv(), keys);
+    } // for
+} // hashfn_suite()
+
+
+int main(int argc, char **argv)
+{
+    uint max = 1000000;
+    if( argc > 1 ) max = atoi(argv[1]);
+
+    bool all = argc < 3;
+    bool list = all, pool = all, udll = all, hash = all, sort = all, views = all, load = all, snapshot = all, grow = all, hashfn = all;
+    for(int a = 2; a < argc; a++)
+    {
+        if( !strcmp(argv[a], "list") ) list = true;
+        else if( !strcmp(argv[a], "pool") ) pool = true;
+        else if( !strcmp(argv[a], "udll") ) udll = true;
+        else if( !strcmp(argv[a], "hash") ) hash = true;
+        else if( !strcmp(argv[a], "sort") ) sort = true;
+        else if( !strcmp(argv[a], "view") ) views = true;
+        else if( !strcmp(argv[a], "load") ) load = true;
+        else if( !strcmp(argv[a], "snapshot") ) snapshot = true;
+        else if( !strcmp(argv[a], "grow") ) grow = true;
+        else if( !strcmp(argv[a], "hashfn") ) hashfn = true;
+        else
+        {
+            fprintf(stderr, "blib_bench: no suite '%s', try list, pool, udll, hash, sort, view, load, snapshot, grow or hashfn\n", argv[a]);
+            return 1;
+        } // else
+    } // for
+
+    printf("suite,container,op,size,ns_per_elem,allocs_per_elem,bytes_per_elem\n");
+    for(ulong n = 10; n <= max; n *= 10)
+    {
+        if( list )  list_suite(n);
+        if( pool )  pool_suite(n);
+        if( udll )  udll_suite(n);
+        if( hash )  hash_suite(n);
+        if( sort )  sort_suite(n);
+        if( views ) view_suite(n);
+        if( load )  load_suite(n);
+        if( snapshot ) snapshot_suite(n);
+        if( grow )  grow_suite(n);
+        if( hashfn ) hashfn_suite(n);
+        fflush(stdout);
+    } // for
+
+    return 0;
+} // main()
+
+// blib_bench.cxx
@@ -0,0 +1,617 @@
+/*****************************************************************************/
+/*** Software: AMOS v0.01 (c)1998 All Rights Reserved by Bradley B. Custer ***/
+/*****************************************************************************/
+
+// File    : adll.cxx
+// Purpose : contains template function members of adllist class (adll.h)
+//
+// Update Log -
+//
+// 20261017 - Begun
+
+
+// array doublely-linked list class header
+#include "adll.h"
+
+#include <algorithm>   // for std::stable_sort()
+#include <functional>  // for std::less
+#include <utility>     // for std::move()
+
+
+namespace blib
+{
+
+
+// Template : uint adllist<T, BY_VALUE>::take(void)
+// Purpose  : get a slot for a new node, the most recently freed
+//            slot if there is one, otherwise a new one at the end
+//            of the array, which may move the array
+// Returns  : the slot, ADLL_NIL if the array holds as many slots
+//            as a 32 bit index can name
+template <class T, bool BY_VALUE>
+uint adllist<T, BY_VALUE>::take(void)
+{
+    if( freed != ADLL_NIL )
+    {   uint n = freed;
+        freed = slots[n].next;
+        return n;
+    } // if
+    if( slots.size() >= ADLL_NIL ) return ADLL_NIL;  // no index left to name it
+    slots.push_back(adllslot<T, BY_VALUE>());
+    return slots.size() - 1;
+}  // template adllist<T, BY_VALUE>::take()
+
+
+// Template : uint adllist<T, BY_VALUE>::place(T *a, bool copy)
+// Purpose  : take() a slot and set it to 'a', or a copy of *a if copy
+// Returns  : the slot, ADLL_NIL if none could be had
+template <class T, bool BY_VALUE>
+inline uint adllist<T, BY_VALUE>::place(T *a, bool copy)
+{
+    return place(a, copy, std::integral_constant<bool, BY_VALUE>());
+}  // template adllist<T, BY_VALUE>::place()
+
+
+// Template : uint adllist<T, BY_VALUE>::place(T *a, bool copy, std::false_type)
+// Purpose  : place() for a list of pointers
+template <class T, bool BY_VALUE>
+uint adllist<T, BY_VALUE>::place(T *a, bool copy, std::false_type)
+{
+    uint n = take();
+    if( n == ADLL_NIL ) return ADLL_NIL;
+    if( !copy ) slots[n].set(a);
+    else if( !slots[n].set_copy(*a) )  // memory allocation failed
+    {   slots[n].next = freed;
+        freed = n;
+        return ADLL_NIL;
+    } // else if
+    return n;
+}  // template adllist<T, BY_VALUE>::place()
+
+
+// Template : uint adllist<T, BY_VALUE>::place(T *a, bool copy, std::true_type)
+// Purpose  : place() for a list of values, *a is copied into the
+//            slot either way, first to a local if it is one of our
+//            own values, which take() may move when the array grows
+template <class T, bool BY_VALUE>
+uint adllist<T, BY_VALUE>::place(T *a, bool copy, std::true_type)
+{
+    std::less<const void *> before;
+    if( !slots.empty() && !before(a, &slots.front()) && before(a, &slots.back() + 1) )
+    {   T keep = *a;
+        return place(&keep, copy, std::true_type());
+    } // if
+    uint n = take();
+    if( n == ADLL_NIL ) return ADLL_NIL;
+    slots[n].set(a);
+    return n;
+}  // template adllist<T, BY_VALUE>::place()
+
+
+// Template : void adllist<T, BY_VALUE>::link_before(uint n, uint at)
+// Purpose  : link slot 'n' into the ring just before slot 'at',
+//            or, if 'at' is ADLL_NIL, as the only node of the list
+// Note     : head is not moved, unless the list was empty
+template <class T, bool BY_VALUE>
+void adllist<T, BY_VALUE>::link_before(uint n, uint at)
+{
+    if( at == ADLL_NIL )
+    {   slots[n].next = slots[n].prior = n;
+        head = n;
+    } // if
+    else
+    {   uint p = slots[at].prior;
+        slots[n].next  = at;
+        slots[n].prior = p;
+        slots[p].next  = n;
+        slots[at].prior = n;
+    } // else
+    length++;
+}  // template adllist<T, BY_VALUE>::link_before()
+
+
+// Template : void adllist<T, BY_VALUE>::unlink(uint n, bool destroy)
+// Purpose  : unlink slot 'n' from the ring and put it at the front of
+//            the free slots, deleting its value first if destroy,
+//            a freed slot's prior is ADLL_NIL
+template <class T, bool BY_VALUE>
+void adllist<T, BY_VALUE>::unlink(uint n, bool destroy)
+{
+    if( length == 1 ) head = ADLL_NIL;
+    else
+    {   uint p = slots[n].prior, x = slots[n].next;
+        slots[p].next  = x;
+        slots[x].prior = p;
+        if( head == n ) head = x;
+    } // else
+    slots[n].clear(destroy);
+    slots[n].prior = ADLL_NIL;
+    slots[n].next  = freed;
+    freed = n;
+    length--;
+}  // template adllist<T, BY_VALUE>::unlink()
+
+
+// Template : uint adllist<T, BY_VALUE>::slot_num(uint i) const
+// Purpose  : find the slot of the i-th value, walking
+//            from whichever end of the list is nearer
+// Note     : i must be < length
+template <class T, bool BY_VALUE>
+uint adllist<T, BY_VALUE>::slot_num(uint i) const
+{
+    uint n = head;
+    if( i <= length / 2 )
+        while( i-- ) n = slots[n].next;
+    else
+        for(i = length - i; i--;) n = slots[n].prior;
+    return n;
+}  // template adllist<T, BY_VALUE>::slot_num()
+
+
+// Template : uint adllist<T, BY_VALUE>::find(const T *a) const
+// Purpose  : find the first slot whose value pointer is 'a'
+// Returns  : the slot, ADLL_NIL if there is none
+template <class T, bool BY_VALUE>
+uint adllist<T, BY_VALUE>::find(const T *a) const
+{
+    uint n = head;
+    for(uint k = length; k--; n = slots[n].next)
+        if( slots[n].get() == a ) return n;
+    return ADLL_NIL;
+}  // template adllist<T, BY_VALUE>::find()
+
+
+// Template : adllist<T, BY_VALUE>::operator=(const adllist<T, BY_VALUE> &a)
+// Purpose  : copy adllist; *this is purge()d and then turned into a
+//            duplicate copy of 'a', pointers are copied NOT instances,
+//            unless BY_VALUE, the new slots are in list order
+template <class T, bool BY_VALUE>
+void adllist<T, BY_VALUE>::operator=(const adllist<T, BY_VALUE> &a)
+{
+    if( &a == this ) return;
+    purge();
+    slots.reserve(a.length);
+    *this += a;
+}  // template adllist<T, BY_VALUE>::operator=()
+
+
+// Template : adllist<T, BY_VALUE>::operator+=(const adllist<T, BY_VALUE> &a)
+// Purpose  : add argument's values to end of *this
+// Note     : *this += *this doubles the list
+template <class T, bool BY_VALUE>
+void adllist<T, BY_VALUE>::operator+=(const adllist<T, BY_VALUE> &a)
+{
+    uint n = a.head;
+    for(uint k = a.length; k--; n = a.slots[n].next)  // a.length fixed now, in case &a == this
+        if( !add(a.slots[n].get()) ) return;  // no slot left
+}  // template adllist<T, BY_VALUE>::operator+=()
+
+
+// Template : uint adllist<T, BY_VALUE>::push(T *newvalue)
+// Purpose  : add newvalue at the front of the list
+// Returns  : 0 no slot could be had
+//            new legnth of list otherwise
+template <class T, bool BY_VALUE>
+uint adllist<T, BY_VALUE>::push(T *newvalue)
+{
+    uint n = place(newvalue, false);
+    if( n == ADLL_NIL ) return 0;
+    link_before(n, head);
+    head = n;
+    return length;
+}  // template adllist<T, BY_VALUE>::push()
+
+
+// Template : uint adllist<T, BY_VALUE>::add(T *newvalue)
+// Purpose  : add newvalue at the end of the list
+// Returns  : 0 no slot could be had
+//            new legnth of list otherwise
+template <class T, bool BY_VALUE>
+uint adllist<T, BY_VALUE>::add(T *newvalue)
+{
+    uint n = place(newvalue, false);
+    if( n == ADLL_NIL ) return 0;
+    link_before(n, head);  // before the head is the end of the ring
+    return length;
+}  // template adllist<T, BY_VALUE>::add()
+
+
+// Template : uint adllist<T, BY_VALUE>::add_copy(const T &newvalue)
+// Purpose  : add a copy of newvalue at the end of the list,
+//            built with T::operator=()
+// Returns  : 0 no slot, or copy, could be had
+//            new legnth of list otherwise
+template <class T, bool BY_VALUE>
+uint adllist<T, BY_VALUE>::add_copy(const T &newvalue)
+{
+    uint n = place(const_cast<T *>(&newvalue), true);
+    if( n == ADLL_NIL ) return 0;
+    link_before(n, head);
+    return length;
+}  // template adllist<T, BY_VALUE>::add_copy()
+
+
+// Template : uint adllist<T, BY_VALUE>::add_num(T *newvalue, uint num)
+// Purpose  : add newvalue at num-th position of the list, the old
+//            num-th value is moved -down- in the list, a num past
+//            the end adds newvalue at the end
+// Returns  : 0 no slot could be had
+//            new legnth of list otherwise
+template <class T, bool BY_VALUE>
+uint adllist<T, BY_VALUE>::add_num(T *newvalue, uint num)
+{
+    if( !num ) return push(newvalue);
+    if( num >= length ) return add(newvalue);
+    uint at = slot_num(num);
+    uint n  = place(newvalue, false);
+    if( n == ADLL_NIL ) return 0;
+    link_before(n, at);
+    return length;
+}  // template adllist<T, BY_VALUE>::add_num()
+
+
+// Template : bool adllist<T, BY_VALUE>::pop(void)
+// Purpose  : remove the first value, does not delete it
+// Returns  : false if the list was empty
+template <class T, bool BY_VALUE>
+bool adllist<T, BY_VALUE>::pop(void)
+{
+    if( !length ) return false;
+    unlink(head, false);
+    return true;
+}  // template adllist<T, BY_VALUE>::pop()
+
+
+// Template : bool adllist<T, BY_VALUE>::pop_delete(void)
+// Purpose  : remove the first value, and DELETE it
+// Returns  : false if the list was empty
+template <class T, bool BY_VALUE>
+bool adllist<T, BY_VALUE>::pop_delete(void)
+{
+    if( !length ) return false;
+    unlink(head, true);
+    return true;
+}  // template adllist<T, BY_VALUE>::pop_delete()
+
+
+// Template : bool adllist<T, BY_VALUE>::remove(const T *oldvalue)
+// Purpose  : removes first oldvalue from list comparing pointer values,
+//            does not delete T object
+// Returns  : true -- oldvalue was found and removed from list
+//            false -- oldvalue was not found
+template <class T, bool BY_VALUE>
+bool adllist<T, BY_VALUE>::remove(const T *oldvalue)
+{
+    uint n = find(oldvalue);
+    if( n == ADLL_NIL ) return false;
+    unlink(n, false);
+    return true;
+}  // template adllist<T, BY_VALUE>::remove()
+
+
+// Template : bool adllist<T, BY_VALUE>::remove_delete(T *oldvalue)
+// Purpose  : removes first oldvalue from list comparing pointer values,
+//            and DELETES the T object
+// Returns  : true -- oldvalue was found and removed from list
+//            false -- oldvalue was not found
+template <class T, bool BY_VALUE>
+bool adllist<T, BY_VALUE>::remove_delete(T *oldvalue)
+{
+    uint n = find(oldvalue);
+    if( n == ADLL_NIL ) return false;
+    unlink(n, true);
+    return true;
+}  // template adllist<T, BY_VALUE>::remove_delete()
+
+
+// Template : bool adllist<T, BY_VALUE>::remove(const T &oldvalue)
+// Purpose  : removes first value equal to oldvalue, comparing
+//            with T::operator==(), does not delete it
+// Returns  : true -- oldvalue was found and removed from list
+//            false -- oldvalue was not found
+template <class T, bool BY_VALUE>
+bool adllist<T, BY_VALUE>::remove(const T &oldvalue)
+{
+    uint n = head;
+    for(uint k = length; k--; n = slots[n].next)
+    {   const T *v = slots[n].get();
+        if( v && *v == oldvalue )
+        {   unlink(n, false);
+            return true;
+        } // if
+    } // for
+    return false;
+}  // template adllist<T, BY_VALUE>::remove()
+
+
+// Template : bool adllist<T, BY_VALUE>::remove_last(void)
+// Purpose  : remove the last value, does not delete it
+// Returns  : false if the list was empty
+template <class T, bool BY_VALUE>
+bool adllist<T, BY_VALUE>::remove_last(void)
+{
+    if( !length ) return false;
+    unlink(slots[head].prior, false);
+    return true;
+}  // template adllist<T, BY_VALUE>::remove_last()
+
+
+// Template : bool adllist<T, BY_VALUE>::remove_num(uint num)
+// Purpose  : remove the num-th value, does not delete it
+// Returns  : false if num is past the end of the list
+template <class T, bool BY_VALUE>
+bool adllist<T, BY_VALUE>::remove_num(uint num)
+{
+    if( num >= length ) return false;
+    unlink(slot_num(num), false);
+    return true;
+}  // template adllist<T, BY_VALUE>::remove_num()
+
+
+// Template : bool adllist<T, BY_VALUE>::remove_handle(adllhandle h)
+// Purpose  : remove the value in slot 'h', does not delete it
+// Returns  : false if 'h' names no value of the list
+template <class T, bool BY_VALUE>
+bool adllist<T, BY_VALUE>::remove_handle(adllhandle h)
+{
+    if( h >= slots.size() || slots[h].prior == ADLL_NIL ) return false;
+    unlink(h, false);
+    return true;
+}  // template adllist<T, BY_VALUE>::remove_handle()
+
+
+// Template : void adllist<T, BY_VALUE>::purge(void)
+// Purpose  : removes every value from the list and frees the array,
+//            but does NOT DELETE the values pointed to
+template <class T, bool BY_VALUE>
+void adllist<T, BY_VALUE>::purge(void)
+{
+    std::vector< adllslot<T, BY_VALUE> >().swap(slots);
+    head = freed = ADLL_NIL;
+    length = 0;
+}  // template adllist<T, BY_VALUE>::purge()
+
+
+// Template : void adllist<T, BY_VALUE>::free_all(void)
+// Purpose  : deletes every value in the list and then purge()s it
+template <class T, bool BY_VALUE>
+void adllist<T, BY_VALUE>::free_all(void)
+{
+    uint n = head;
+    for(uint k = length; k--; n = slots[n].next)
+        slots[n].clear(true);
+    purge();
+}  // template adllist<T, BY_VALUE>::free_all()
+
+
+// Template : void adllist<T, BY_VALUE>::reserve(uint n)
+// Purpose  : grow the array to room for 'n' slots now, so that
+//            adds up to then neither allocate nor move the array
+template <class T, bool BY_VALUE>
+void adllist<T, BY_VALUE>::reserve(uint n)
+{
+    slots.reserve(n);
+}  // template adllist<T, BY_VALUE>::reserve()
+
+
+// Template : void adllist<T, BY_VALUE>::compact(void)
+// Purpose  : move the values into slots 0..size()-1 in list order,
+//            dropping the free slots, so that walking the list reads
+//            the array straight through once more after many adds and
+//            removes or a sort
+// Note     : every handle and iterator of the list is invalidated
+template <class T, bool BY_VALUE>
+void adllist<T, BY_VALUE>::compact(void)
+{
+    std::vector< adllslot<T, BY_VALUE> > packed;
+    packed.reserve(length);
+    uint n = head;
+    for(uint k = 0; k < length; k++, n = slots[n].next)
+    {   packed.push_back(std::move(slots[n]));
+        packed[k].next  = k + 1 < length ? k + 1 : 0;
+        packed[k].prior = k ? k - 1 : length - 1;
+    } // for
+    slots.swap(packed);
+    head  = length ? 0 : ADLL_NIL;
+    freed = ADLL_NIL;
+}  // template adllist<T, BY_VALUE>::compact()
+
+
+// Template : uint adllist<T, BY_VALUE>::sort(void)
+// Purpose  : sorts the list greatest-to-least comparing
+//            values with T::operator<(const T&)
+// Returns  : number of comparisons performed for sort
+// Note     : a 0 value is treated as least in list, see array_sort()
+template <class T, bool BY_VALUE>
+uint adllist<T, BY_VALUE>::sort(void)
+{
+    return array_sort( [](T *a, T *b)
+                       { if( !a || !b ) return !a && b; return *a < *b; } );
+} // template adllist<T, BY_VALUE>::sort()
+
+
+// Template : uint adllist<T, BY_VALUE>::sort_dll(void)
+// Purpose  : sorts the list greatest-to-least comparing
+//            values with T::dll_lessthan(const T *)
+// Returns  : number of comparisons performed for sort
+// Note     : a 0 value is treated as least in list, see array_sort()
+template <class T, bool BY_VALUE>
+uint adllist<T, BY_VALUE>::sort_dll(void)
+{
+    return array_sort( [](T *a, T *b)
+                       { if( !a || !b ) return !a && b; return a->dll_lessthan(b); } );
+} // template adllist<T, BY_VALUE>::sort_dll()
+
+
+// Template : uint adllist<T, BY_VALUE>::sort(bool (*)())
+// Purpose  : sorts the list greatest-to-least comparing
+//            values with the function 'lt'
+// Returns  : number of comparisons performed for sort
+// Note     : a 0 value is treated as least in list, see array_sort()
+template <class T, bool BY_VALUE>
+uint adllist<T, BY_VALUE>::sort(bool (*lt)(const T *, const T *))
+{
+    return array_sort( [lt](T *a, T *b)
+                       { if( !a || !b ) return !a && b; return (*lt)(a, b); } );
+} // template adllist<T, BY_VALUE>::sort(bool (*))
+
+
+// Template : uint adllist<T, BY_VALUE>::array_sort(LT lt)
+// Purpose  : stable sort of the list greatest-to-least, 'lt(a,b)' must
+//            return true if value 'a' is less than value 'b'
+//            the slot indices are sorted with std::stable_sort() and
+//            the ring relinked in their order, so no value moves and
+//            handles and iterators stay on their values
+// Returns  : number of comparisons performed for sort
+template <class T, bool BY_VALUE> template <class LT>
+uint adllist<T, BY_VALUE>::array_sort(LT lt)
+{
+    if( length < 2 ) return 0;
+    std::vector<uint> order(length);
+    uint n = head;
+    for(uint k = 0; k < length; k++, n = slots[n].next)
+        order[k] = n;
+
+    uint comparisons = 0;
+    std::stable_sort(order.begin(), order.end(),
+                     [this, &lt, &comparisons](uint a, uint b)
+                     { comparisons++; return lt(slots[b].get(), slots[a].get()); } );
+
+    for(uint k = 0; k < length; k++)
+    {   slots[order[k]].next  = order[k + 1 < length ? k + 1 : 0];
+        slots[order[k]].prior = order[k ? k - 1 : length - 1];
+    } // for
+    head = order[0];
+    return comparisons;
+} // template adllist<T, BY_VALUE>::array_sort()
+
+
+// Template : bool adllist<T, BY_VALUE>::in_list(const T *a) const
+// Purpose  : report if pointer value 'a' is in the list
+template <class T, bool BY_VALUE>
+bool adllist<T, BY_VALUE>::in_list(const T *a) const
+{
+    return find(a) != ADLL_NIL;
+}  // template adllist<T, BY_VALUE>::in_list()
+
+
+// Template : T *adllist<T, BY_VALUE>::ref_in_list(const T &a) const
+// Purpose  : return the first value equal to 'a', by T::operator==()
+// Returns  : 0 if there is none
+template <class T, bool BY_VALUE>
+T *adllist<T, BY_VALUE>::ref_in_list(const T &a) const
+{
+    uint n = head;
+    for(uint k = length; k--; n = slots[n].next)
+    {   T *v = slots[n].get();
+        if( v && *v == a ) return v;
+    } // for
+    return 0;
+}  // template adllist<T, BY_VALUE>::ref_in_list()
+
+
+// Template : T *adllist<T, BY_VALUE>::match_in_list(const string &key) const
+// Purpose  : return the first value for which T::matches(key) is true
+// Returns  : 0 if there is none
+template <class T, bool BY_VALUE>
+T *adllist<T, BY_VALUE>::match_in_list(const string &key) const
+{
+    uint n = head;
+    for(uint k = length; k--; n = slots[n].next)
+    {   T *v = slots[n].get();
+        if( v && v->matches(key) ) return v;
+    } // for
+    return 0;
+}  // template adllist<T, BY_VALUE>::match_in_list()
+
+
+// Template : T *adllist<T, BY_VALUE>::get_num(const uint i) const
+// Purpose  : return the i-th value
+// Returns  : 0 if i is past the end of the list
+template <class T, bool BY_VALUE>
+T *adllist<T, BY_VALUE>::get_num(const uint i) const
+{
+    if( i >= length ) return 0;
+    return slots[slot_num(i)].get();
+}  // template adllist<T, BY_VALUE>::get_num()
+
+
+// Template : uint adllit<T, BY_VALUE>::remove(void)
+// Purpose  : removes the value the iterator is pointing to,
+//            does NOT DELETE the T object
+// Returns  : new legnth of list, 0 if list is (now) empty
+// Notes    : the iterator moves on to the next value, and
+//            step_made is handled as in dllit<T>::remove(), so
+//            a loop removing values should skip its ++ after
+//            a remove, as in
+//            for(adllit<T> i(list); !i.done();)
+//              if( -something- ) i.remove(); else ++i;
+template <class T, bool BY_VALUE>
+uint adllit<T, BY_VALUE>::remove(void)
+{
+    if( !list.length || at == ADLL_NIL ) return 0;
+    bool resetting_head = at == list.head;
+    uint next = list.slots[at].next;
+    list.unlink(at, false);
+    if( !list.length ) { at = ADLL_NIL; i = 0; }
+    else
+    {   at = next;
+        if( i >= list.length ) i = 0;  // was the last value, now pointing at head
+    } // else
+    if( !resetting_head ) step_made = true;
+    return list.length;
+} // template adllit<T, BY_VALUE>::remove()
+
+
+// Template : uint adllit<T, BY_VALUE>::remove_delete(void)
+// Purpose  : removes the value the iterator is pointing to,
+//            and DELETES the T object
+// Returns  : new legnth of list, 0 if list is (now) empty
+// Notes    : same as remove()
+template <class T, bool BY_VALUE>
+uint adllit<T, BY_VALUE>::remove_delete(void)
+{
+    if( !list.length || at == ADLL_NIL ) return 0;
+    list.slots[at].clear(true);
+    return remove();
+} // template adllit<T, BY_VALUE>::remove_delete()
+
+
+// Template : uint adllit<T, BY_VALUE>::add_before(T *a)
+// Purpose  : link a new value in just before the iterator's value
+// Returns  : 0 no slot could be had
+//            new legnth of list otherwise
+// Notes    : the iterator stays on the same value, a value added
+//            before the head becomes the new head
+template <class T, bool BY_VALUE>
+uint adllit<T, BY_VALUE>::add_before(T *a)
+{
+    if( at == ADLL_NIL ) { operator=(a); return list.length; }
+    uint n = list.place(a, false);
+    if( n == ADLL_NIL ) return 0;
+    list.link_before(n, at);
+    if( at == list.head ) list.head = n;
+    i++;
+    return list.length;
+} // template adllit<T, BY_VALUE>::add_before()
+
+
+// Template : uint adllit<T, BY_VALUE>::add_after(T *a)
+// Purpose  : link a new value in just after the iterator's value
+// Returns  : 0 no slot could be had
+//            new legnth of list otherwise
+// Notes    : the iterator stays on the same value
+template <class T, bool BY_VALUE>
+uint adllit<T, BY_VALUE>::add_after(T *a)
+{
+    if( at == ADLL_NIL ) { operator=(a); return list.length; }
+    uint n = list.place(a, false);
+    if( n == ADLL_NIL ) return 0;
+    list.link_before(n, list.slots[at].next);
+    return list.length;
+} // template adllit<T, BY_VALUE>::add_after()
+
+
+} // namespace blib
+
+// adll.cxx
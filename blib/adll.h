@@ -0,0 +1,312 @@
+/*****************************************************************************/
+/*** Software: AMOS v0.01 (c)1998 All Rights Reserved by Bradley B. Custer ***/
+/*****************************************************************************/
+
+// File    : adll.h
+// Purpose : contains templates for an array doublely-linked list ADT
+//           adllist keeps its nodes, adllslot, in one growable array
+//           and links them by 32 bit array index rather than pointer
+//
+// Update Log -
+//
+// 20261017 - Begun, with the dllist methods and iterator protocol, and handles
+// 20261017 - set_copy() news its copy nothrow, so a failed allocation returns false
+
+
+#ifndef ARRAY_DOUBLELY_LINKED_LIST_TEMPLATE
+#define ARRAY_DOUBLELY_LINKED_LIST_TEMPLATE
+
+
+#include <string>
+#include <vector>       // for the slot array
+#include <type_traits>  // for std::true_type
+#include <new>          // for std::nothrow
+#include "blib.h"       // blib defines
+
+
+using std::string;
+
+
+namespace blib
+{
+
+
+// prototypes
+template <class T, bool BY_VALUE> struct adllslot;
+template <class T, bool BY_VALUE = false> class adllist;
+template <class T, bool BY_VALUE = false> class adllit;
+template <class T, bool BY_VALUE = false> class cadllit;
+
+
+// a handle names one slot of an adllist, and so one value of it,
+//  for as long as the value is in the list, ADLL_NIL names no slot
+typedef uint adllhandle;
+#define  ADLL_NIL  0xFFFFFFFFu
+
+
+// Template : struct adllslot
+// Purpose  : one node of an adllist, the value pointer and the array
+//            indices of the next and prior slots, 16 bytes on a 64 bit
+//            build, against 24 for a dllitem, a free slot is linked
+//            into the list's free slots through next
+template <class T> struct adllslot<T, false>
+{
+    T     *value;
+    uint   next;
+    uint   prior;
+
+    adllslot(void) : value(0), next(ADLL_NIL), prior(ADLL_NIL) {}
+    T *get(void) const               { return value; }
+    void set(T *a)                   { value = a; }                  // point at 'a'
+    bool set_copy(const T &a)        // point at a new copy of 'a'
+        { value = new (std::nothrow) T; if( !value ) return false; *value = a; return true; }
+    void clear(bool destroy)         // forget the value, deleting it if destroy
+        { if( destroy ) delete value; value = 0; }
+}; // template struct adllslot<T, false>
+
+
+// Template : struct adllslot
+// Purpose  : one node of an adllist holding its T in the slot itself,
+//            so a value costs sizeof(T) + 8 bytes with no allocation
+//            of its own, and walking the list reads the values in place
+// Note     : T needs a default constructor and operator=(),
+//            a free slot holds a default constructed T
+template <class T> struct adllslot<T, true>
+{
+    T      value;
+    uint   next;
+    uint   prior;
+
+    adllslot(void) : next(ADLL_NIL), prior(ADLL_NIL) {}
+    T *get(void) const               { return const_cast<T *>(&value); }
+    void set(T *a)                   { value = *a; }                 // copy *a in
+    bool set_copy(const T &a)        { value = a; return true; }
+    void clear(bool)                 { value = T(); }                // the T goes with its slot
+}; // template struct adllslot<T, true>
+
+
+// Template: class adllist
+// Purpose : doublely-linked list, with the method names and iterator
+//           protocol of dllist<T>, whose nodes are slots of one array
+//           linked by 32 bit index, a removed node's slot is reused
+//           by the next add, so with pointer values a node is 16 bytes
+//           and no allocation is made per node once the array has grown,
+//           and walking a list built in order reads the array in order
+// Note    : BY_VALUE true stores each T in its slot, rather than a pointer
+//           to a T kept elsewhere, add(T *) and push(T *) then copy the
+//           T pointed to in, and the value pointers returned point into
+//           the array, so they are good only until the array next grows
+//           (see reserve()), the *_delete() methods are the same as the
+//           plain ones, the T goes when its slot is freed
+// Note    : a handle, or an iterator, names a slot, so it stays on its
+//           value through any adds and removes of other values, and sorts,
+//           only compact() moves values to other slots
+// Warning : with BY_VALUE false, just like dllist, the values pointed to
+//           are NOT DELETED when the list is purged, deleted, or a value
+//           removed, use free_all() or the *_delete() methods for that
+// Note    : positional access walks from the nearest end of the list
+template <class T, bool BY_VALUE> class adllist
+{
+    private:
+        std::vector< adllslot<T, BY_VALUE> > slots;   // every node, in use or free
+        uint head;                        // slot of first value, ADLL_NIL if empty
+        uint freed;                       // first free slot, ADLL_NIL if none
+        uint length;                      // length of list
+
+        friend class adllit<T, BY_VALUE>;
+        friend class cadllit<T, BY_VALUE>;
+
+        uint take(void);                  // a free slot, from freed or by growing slots, ADLL_NIL if full
+        uint place(T *, bool);            // take() a slot and set() it to the value, or to a copy if asked
+        uint place(T *, bool, std::false_type);
+        uint place(T *, bool, std::true_type);   // BY_VALUE, the value may be in the array take() grows
+        void link_before(uint, uint);     // link slot n into the ring before slot at, or as the only slot
+        void unlink(uint, bool);          // unlink slot n and free it, deleting its value if asked
+        uint slot_num(uint) const;        // slot of i-th value (i < length)
+        uint find(const T *) const;       // slot pointing at the value, ADLL_NIL if none
+        template <class LT> uint array_sort(LT);  // stable greatest-to-least relink by a value less-than
+
+    public:
+        typedef cadllit<T, BY_VALUE> citerator;   // const iterator type, for templates taking any blib list
+
+        // constructors
+        adllist() : head(ADLL_NIL), freed(ADLL_NIL), length(0) {}
+        adllist(const adllist<T, BY_VALUE> &a) : head(ADLL_NIL), freed(ADLL_NIL), length(0)
+            { operator=(a); }
+        // destructor
+        ~adllist() { purge(); }  // with BY_VALUE false this does not delete values pointed to
+
+        // mutators
+        void operator=(const adllist<T, BY_VALUE> &);   // assign *this to a copy of arguement's values (pointers unless BY_VALUE)
+        void operator+=(const adllist<T, BY_VALUE> &);  // add copy of argument's values to end of *this
+        uint push(T *);                       // adds new value at beginning of list
+        uint add(T *);                        // adds new value at end of list
+        uint add_copy(const T&);              // adds new value, a copy of the argument built with T::operator=()
+        uint add_num(T *, uint);              // add a value in i-th position
+        bool pop(void);                       // removes first value from list, does not delete T objects
+        bool pop_delete(void);                // removes first value from list, and DELETES T object it points to
+        bool remove(const T*);                // removes first oldvalue from list comparing pointer values, does not delete T objects
+        bool remove_delete(T*);               // removes first oldvalue from list comparing pointer values, DOES DELETE it
+        bool remove(const T&);                // removes first oldvalue from list comparing with T::operator==(), does not delete it
+        bool remove_last(void);               // removes last value from list, does not delete T objects
+        bool remove_num(uint);                // removes i-th value from list, does not delete T objects
+        bool remove_handle(adllhandle);       // removes the value in the handle's slot, does not delete T objects
+        void purge(void);                     // removes every value from the list, does not delete T objects
+        void free_all(void);                  // deletes every value in the list, DELETES the T objects
+        void reserve(uint);                   // make room for this many values without the array growing
+        void compact(void);                   // move the values to slots 0..size()-1 in list order, invalidates handles & iterators
+        uint sort(void);                      // sorts the list greast-to-least with T::operator<(const T&)
+        uint sort_dll(void);                  // sorts the list greast-to-least with T::dll_lessthan(const T*)
+        uint sort(bool (*)(const T*, const T*));
+
+        // inspectors
+        bool in_list(const T*) const;              // report if argument is in list, comparing pointer values
+        T* ref_in_list(const T&) const;            // return 1st match to argument in list, comparing with T::operator==()
+        T* match_in_list(const string&) const;     // return 1st match to string key in list, comparing with "bool T::matches(const string&) const"
+        T& operator[](uint i) const                // return reference to ith value
+            { return *get_num(i); }
+        T* get_num(const uint) const;              // return pointer to ith value, 0 if past end
+        T* get_handle(adllhandle h) const          // return the value in the handle's slot
+            { return slots[h].get(); }
+        adllhandle first_handle(void) const        // handle of first value, ADLL_NIL if empty
+            { return head; }
+        adllhandle last_handle(void) const         // handle of last value, ADLL_NIL if empty
+            { if( length ) return slots[head].prior; return ADLL_NIL; }
+        T* first(void) const                       // return first value
+            { if( length ) return slots[head].get(); else return 0; }
+        T* last(void) const                        // return last value
+            { if( length ) return slots[slots[head].prior].get(); else return 0; }
+        bool empty(void) const                     // report if list is empty
+            { if( length ) return false; else return true; }
+        uint size(void) const { return length; }    // report size of list
+        uint capacity(void) const                  // values the array holds before it grows
+            { return slots.capacity(); }
+}; // template class adllist
+
+
+// Template : class adllit
+// Purpose  : iterator class for adllist, used just as dllit
+//            for(adllit<T> i(list); !i.finished(); ++i) ;
+// Note     : the iterator names a slot, so adds and removes elsewhere
+//            in the list, even ones that grow the array, leave it on
+//            the same value, though num() counts from where it started
+template <class T, bool BY_VALUE> class adllit
+{
+    private:
+        uint                    at;         // slot of current iteration
+        adllist<T, BY_VALUE>    &list;      // list being iterated
+        bool                    step_made;  // flags whether iteration has begun
+        uint                    i;          // maintains iterative position
+
+    public:
+        // constructor
+        adllit(adllist<T, BY_VALUE> &L) : at(L.head), list(L), step_made(false), i(0) {}
+        adllit(adllist<T, BY_VALUE> &L, const uint &s)
+            : at(L.head), list(L), step_made(false), i(0)
+            { start_at(s); }
+
+        // mutators
+        void start(void)           // start iteration over again
+            { at = list.head; step_made = false; i = 0; }
+        void start_at(const uint& s)  // same as start() then s ++'s, positions past the end wrap around
+            { start(); if( !list.length || !s ) return;
+              i = s % list.length; at = list.slot_num(i); step_made = true; }
+        T *operator++(void)        // increment element being pointed to
+            { step_made = true; if( at == ADLL_NIL ) return 0;
+              at = list.slots[at].next;
+              if( at == list.head ) i = 0; else i++;
+              return list.slots[at].get(); }
+        T *operator--(void)        // decrement element being pointed to
+            { step_made = true; if( at == ADLL_NIL ) return 0;
+              at = list.slots[at].prior;
+              if( i ) i--; else i = list.length - 1;
+              return list.slots[at].get(); }
+        T *operator=(T *a)         // assign value of element pointed to
+            { if( at != ADLL_NIL ) list.slots[at].set(a);
+              else { list.add(a); start(); } return a; }
+        uint add_before(T *);      // adds value before iterator position, iterator stays on the same value
+        uint add_after(T *);       // adds value after iterator position, iterator stays on the same value
+        uint remove(void);         // remove current iteration from list, does NOT DELETE value object
+        uint remove_delete(void);  // remove current iteration from list, WILL DELETE value object
+
+        // inspectors
+        uint num(void) const       // return iteration position
+            { return i; }
+        adllhandle handle(void) const  // handle of current iteration
+            { return at; }
+        T *operator()(void) const  // inspect value interator is pointing to
+            { if( at != ADLL_NIL ) return list.slots[at].get(); return 0; }
+        bool at_start(void) const  // is iterator pointing to first element?
+            { if( list.length ) return at == list.head; return false; }
+        bool at_end(void) const    // is iterator pointing to last element?
+            { if( list.length ) return at == list.slots[list.head].prior; return true; }
+        bool finished(void) const  // has a full list iteration occured ?
+            { if( list.length )
+              { if( step_made ) return at == list.head; else return false; }
+              return true; }
+        bool done(void) const      // second name for finished()
+            { return finished(); }
+}; // template class adllit
+
+
+// Template : class cadllit
+// Purpose  : const iterator class for adllist, used just as cdllit
+template <class T, bool BY_VALUE> class cadllit
+{
+    private:
+        uint                        at;         // slot of current iteration
+        const adllist<T, BY_VALUE>  &list;      // list being iterated
+        bool                        step_made;  // flags whether iteration has begun
+        uint                        i;          // maintains iterative position
+
+    public:
+        // constructor
+        cadllit(const adllist<T, BY_VALUE> &L) : at(L.head), list(L), step_made(false), i(0) {}
+        cadllit(const adllist<T, BY_VALUE> &L, const uint &s)
+            : at(L.head), list(L), step_made(false), i(0)
+            { start_at(s); }
+
+        // mutators
+        void start(void)           // start iteration over again
+            { at = list.head; step_made = false; i = 0; }
+        void start_at(const uint& s)  // same as start() then s ++'s, positions past the end wrap around
+            { start(); if( !list.length || !s ) return;
+              i = s % list.length; at = list.slot_num(i); step_made = true; }
+        T *operator++(void)        // increment element being pointed to
+            { step_made = true; if( at == ADLL_NIL ) return 0;
+              at = list.slots[at].next;
+              if( at == list.head ) i = 0; else i++;
+              return list.slots[at].get(); }
+        T *operator--(void)        // decrement element being pointed to
+            { step_made = true; if( at == ADLL_NIL ) return 0;
+              at = list.slots[at].prior;
+              if( i ) i--; else i = list.length - 1;
+              return list.slots[at].get(); }
+
+        // inspectors
+        uint num(void) const       // return iteration position
+            { return i; }
+        adllhandle handle(void) const  // handle of current iteration
+            { return at; }
+        T *operator()(void) const  // inspect value interator is pointing to
+            { if( at != ADLL_NIL ) return list.slots[at].get(); return 0; }
+        bool at_start(void) const  // is iterator pointing to first element?
+            { if( list.length ) return at == list.head; return false; }
+        bool at_end(void) const    // is iterator pointing to last element?
+            { if( list.length ) return at == list.slots[list.head].prior; return true; }
+        bool finished(void) const  // has a full list iteration occured ?
+            { if( list.length )
+              { if( step_made ) return at == list.head; else return false; }
+              return true; }
+        bool done(void) const      // second name for finished()
+            { return finished(); }
+}; // template class cadllit
+
+
+} // namespace blib
+
+#include "adll.cxx"   // included b/c adllist is a set of template classes, not compilable itself
+
+#endif // ARRAY_DOUBLELY_LINKED_LIST_TEMPLATE
+
+// adll.h
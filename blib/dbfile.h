@@ -7,6 +7,7 @@
 //   20120412 - added add_rec(), add_if_missing(), update(), find(), InList(), copy_if_found() and get_*()
 //   20150506 - fixed copy_if_found() and get_*() functions to be const
 //   20150507 - converted all the char*'s over to using bstring's
+//   20261017 - added a dllhook to DBRecord, so records can also be kept in an idllist
 
 
 
@@ -24,6 +25,7 @@ struct DBRecord;
 
 #include "blib.h"     // blib global typedefs, bstring, etc
 #include "dll.h"      // dllist class
+#include "idll.h"     // dllhook for idllist
 #include "bstring.h"  // bstring class
 
 
@@ -126,6 +128,8 @@ struct DBRecord
     bstring  group;
     bstring  field;
     bstring  value;
+
+    dllhook<DBRecord>  hook;  // links for an idllist<DBRecord, &DBRecord::hook>
 };  // struct DBRecord
 
 
@@ -4,6 +4,7 @@
 // Update Log -
 //
 // 199905014 - Began iDBStream, oDBStream, DBStreamRec
+// 20261017 - added a dllhook to DBStreamRec, so records can also be kept in an idllist
 
 
 // prototypes
@@ -23,6 +24,7 @@ class  oDBStream;
 #include <string>          // class string used in DBStreamRec
 #include "blib.h"          // blib global typedefs, defines, etc
 #include "dll.h"           // for dllist  (doubly linked list)
+#include "idll.h"          // dllhook for idllist
 
 
 namespace blib
@@ -38,6 +40,7 @@ struct DBStreamRec
 {
     char            type;	// record type
     dllist<string>  fields;	// field values of this record
+    dllhook<DBStreamRec>  hook;	// links for an idllist<DBStreamRec, &DBStreamRec::hook>
 
 
     // destructor
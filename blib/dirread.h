@@ -3,6 +3,7 @@
 // Updates -
 // 19990626 - Begun
 // 20090527 - appended #endif comment
+// 20261017 - added a dllhook to DirRec, so records can also be kept in an idllist
 
 
 // prototypes
@@ -20,6 +21,7 @@ struct DirRec;
 #include <string>    // for class string
 #include "blib.h"    // blib global typedefs, defines, etc
 #include "dll.h"     // for class dllist
+#include "idll.h"    // dllhook for idllist
 
 
 namespace blib
@@ -78,6 +80,8 @@ struct DirRec
     string         name;   // name of file
     unsigned long  size;   // size of file
     bool           dir;    // file is a directory
+
+    dllhook<DirRec>  hook; // links for an idllist<DirRec, &DirRec::hook>
 };  // struct DirRec
 
 
@@ -25,11 +25,35 @@
 // 20160916 - rewrote dllist<T>::match2_in_list(const string&, const string&) as dllist<T>::match_in_list(const string&, const string&)
 //            since it a different signature than dllist<T>::match_in_list(const string&), duh!
 // 20160917 - added dllist<T>::match_in_list(const double&)
+// 20261017 - purge() and free_all() give the node ring back to dllpool<T> in one step
+// 20261017 - replaced the insertion sorts of sort(), sort_dll() and sort(bool (*)()) with merge_sort(),
+//            removed swap() which they used, fixed lessthan*() NULL checks to test the node values
+// 20261017 - added node_num() and build_skip(), positional access now walks from the nearest known node
+// 20261017 - added index_members() and the dllindex<T> methods, every node added or removed is (un)indexed,
+//            in_list(), ref_in_list(), remove() and the string and integer match_in_list() use the index
+// 20261017 - operator-=() and pUnion() use a hash set of pointers, added Union(const dllist<T>&, H)
+// 20261017 - added parallel_sort(), parallel_sort_dll() and parallel_sort(bool (*)()), with parallel_merge_sort()
+// 20261017 - added sort(LT), sort_by_key() and close_chain(), which the merge sorts now share
+// 20261017 - added radix_sort()
+// 20261017 - operator=() shares the nodes, added free_ring(), release(), unshare() and the detach() calls in every mutator
+// 20261017 - added draw(), rand(G&), sample() and shuffle()
+// 20261017 - add(), add_copy() and add_num() at the end extend the skip index, added dllskip<T>::append()
+// 20261017 - the cursor, indexes and shared count are reached through ext, node_num() only sets the
+//            cursor when it walked
+// 20261017 - moved the parallel sorts and their thread.h include to dllpsort.h
+// 20261017 - radix_sort() returns before its passes when every value is 0
+// 20261017 - ext and the shared count are installed by compare and swap, so a const list can be copied
+//            from several threads, unshare() counts gen up for the iterators
+// 20261017 - node_num() takes and moves the cursor through dllcursor, build_skip() builds under a flag
+//            and returns the nodes it published
 
 
 // doublely-linked list class header
 #include <cstdlib>   // for rand() and srand()
 #include <ctime>     // for time()
+#include <vector>    // for sort_by_key()
+#include <algorithm> // for std::stable_sort()
+#include <type_traits> // for std::decay
 #include "dll.h"
 
 
@@ -42,14 +66,11 @@ namespace blib
 //            but does NOT DELETE the values pointed to
 template <class T> void dllist<T>::purge(void)
 {
-    dllitem<T> *tmp = head, *next;
-    while( length-- )
-    {
-        next = tmp->next;
-        delete tmp;
-        tmp = next;
-    } // while()
+    if( index() ) index()->clear();
+    if( release() )  // unless another copy still holds the nodes
+        free_ring(head, length);
     head = 0; length = 0;
+    changed();
 } // template dllist<T>::purge()
 
 
@@ -63,15 +84,11 @@ template <class T> void dllist<T>::purge(void)
 //            '[]' isn't included in value deletes
 template <class T> void dllist<T>::free_all(void)
 {
-    dllitem<T> *tmp = head, *next;
-    while( length-- )
-    {
-        next = tmp->next;
+    if( index() ) index()->clear();  // before the values its keys come from are gone
+    dllitem<T> *tmp = head;
+    for(uint i = length; i--; tmp = tmp->next)
         delete tmp->value;
-        delete tmp;
-        tmp = next;
-    } // while
-    head = 0; length = 0;
+    purge();  // the nodes go as purge() would, they may be shared
 } // template dllist<T>::free_all()
 
 
@@ -79,17 +96,35 @@ template <class T> void dllist<T>::free_all(void)
 // Purpose  : copy dllist; *this is purge()d and then
 //            turned into a duplicate copy of 'a',
 //            pointers are copied NOT instances
+// Note     : this is O(1), *this shares 'a's nodes until either
+//            list is changed, and the one changed first copies
+//            them then (see detach())
+//            'a' is only changed through atomics, its ext and shared
+//            count are installed by compare and swap, so several
+//            threads may copy one list at once, as they may read it
 template <class T>
 void dllist<T>::operator=(const dllist<T> &a)
 {
-    if( length ) purge();  // clear out current nodes
+    if( &a == this ) return;
+    if( length || refs() ) purge();  // clear out current nodes
     if( a.length )
     {
-        dllitem<T> *tmp = a.head;
-        do
-        {   assert( add(tmp->value) );
-            tmp = tmp->next;
-        } while( tmp != a.head );
+        dllext<T> *x = a.extra();
+        std::atomic<uint> *shared = x->refs.load();
+        if( !shared )  // a's first copy, another thread may be making one too
+        {   std::atomic<uint> *made = new std::atomic<uint>(1);
+            if( x->refs.compare_exchange_strong(shared, made) ) shared = made;
+            else delete made;  // shared is the other thread's count
+        } // if
+        shared->fetch_add(1);
+        extra()->refs = shared;
+        head = a.head;
+        length = a.length;
+        if( index() )  // the index now needs the shared nodes
+        {   dllitem<T> *tmp = head;
+            for(uint i = length; i--; tmp = tmp->next)
+                index()->insert(tmp);
+        } // if
     } // if
 }  // template dllist<T>::operator=()
 
@@ -170,6 +205,15 @@ void dllist<T>::push_list(const dllist<T> &a)
 template <class T>
 void dllist<T>::append_and_purge(dllist<T> &a)
 {
+    detach();  // both rings are about to be cut
+    a.detach();
+    if( index() && a.length )  // a's nodes become *this' nodes
+    {   dllitem<T> *tmp = a.head;
+        for(uint i = a.length; i--; tmp = tmp->next)
+            index()->insert(tmp);
+    } // if
+    if( a.index() ) a.index()->clear();
+
     if( !length )   // if *this has no nodes
     {               //  just assign *this' head node to a's
         head   = a.head;
@@ -189,6 +233,7 @@ void dllist<T>::append_and_purge(dllist<T> &a)
     
     a.head   = NULL;
     a.length = 0;
+    a.changed();
 } // template dllist<T>::append_and_purge()
 
 
@@ -200,6 +245,15 @@ void dllist<T>::append_and_purge(dllist<T> &a)
 template <class T>
 void dllist<T>::prepend_and_purge(dllist<T> &a)
 {
+    detach();  // both rings are about to be cut
+    a.detach();
+    if( index() && a.length )  // a's nodes become *this' nodes
+    {   dllitem<T> *tmp = a.head;
+        for(uint i = a.length; i--; tmp = tmp->next)
+            index()->insert(tmp);
+    } // if
+    if( a.index() ) a.index()->clear();
+
     if( !length )   // if *this has no nodes
     {               //  just assign *this' head node to a's
         head   = a.head;
@@ -220,6 +274,8 @@ void dllist<T>::prepend_and_purge(dllist<T> &a)
 
     a.head   = NULL;
     a.length = 0;
+    a.changed();
+    changed();  // positions of *this' old nodes moved
 } // template dllist<T>::prepend_and_purge()
 
 
@@ -227,20 +283,33 @@ void dllist<T>::prepend_and_purge(dllist<T> &a)
 // Purpose  : remove any elements in 'a' found in *this
 //            from *this; the procedure compares pointers
 //            and NOT instances
+// Note     : each node of 'a' removes the first node of *this
+//            with its pointer, so a pointer in 'a' k times removes
+//            its first k nodes in *this, as k calls to remove() would
+//            'a' is tallied into a hash map first, then *this is walked
+//            once, so this is O(n+m) rather than O(n*m)
 template <class T>
 void dllist<T>::operator-=(const dllist<T> &a)
 {
     // if *this or 'a' has no nodes
     if( !length || !a.length)  
         return;    // nothing to do
+    detach();
 
-    // otherwise, iterate 'a' looking for matches in *this
+    // count how many of each pointer 'a' has
+    std::unordered_map<const T *, uint> doomed;
+    doomed.reserve(a.length);
     for(cdllit<T> i(a); !i.finished(); ++i)
-        remove( i() );
+        doomed[i()]++;
 
-    // Note: because remove() only removes the first
-    //  node found which has a value pointer equal to its
-    //  argument, we do not account for duplicates here
+    // then remove that many, from the front of *this
+    for(dllit<T> i(*this); !i.finished() && !doomed.empty();)
+    {
+        auto it = doomed.find(i());
+        if( it == doomed.end() ) { ++i; continue; }
+        if( !--it->second ) doomed.erase(it);
+        i.remove();
+    } // for
 } // template dllist<T>::operator-=()
 
 
@@ -251,8 +320,8 @@ void dllist<T>::operator-=(const dllist<T> &a)
 //            the resulting list (*this) will have new nodes
 //            pointing to THE SAME values pointed to by 'a's
 //            nodes, which where not originally found in *this
-// Note     : I'm certain the algorithm used here
-//            could be improved
+// Note     : the pointers of *this are kept in a hash set, which
+//            each pointer added joins, so this is O(n+m)
 template <class T>
 void dllist<T>::pUnion(const dllist<T> &a)
 {
@@ -262,11 +331,16 @@ void dllist<T>::pUnion(const dllist<T> &a)
         return;
     } // if
 
-    if( a.length )                      // otherwise, verify 'a' has nodes
+    if( a.length && &a != this )        // otherwise, verify 'a' has nodes
     {                                   //  and copy over the unqine ones
+        std::unordered_set<const T *> have;
+        have.reserve(length + a.length);
+        for(cdllit<T> i(*this); !i.finished(); ++i)
+            have.insert(i());
+
         dllitem<T> *tmp = a.head;
         do
-        {   if( !in_list( tmp->value ) )
+        {   if( have.insert(tmp->value).second )
                 assert( add(tmp->value) );
             tmp = tmp->next;
         } while( tmp != a.head );
@@ -307,9 +381,54 @@ void dllist<T>::Union(const dllist<T> &a)
 } // template dllist<T>::Union()
 
 
+// Template : dllist<T>::Union(const dllist<T> &a, H hash)
+// Purpose  : makes *this the Set Union of *this and 'a'
+//            comparing with T::operator==(), just as Union(a)
+//            does, but with the values of *this kept in a hash
+//            set, so this is O(n+m) rather than O(n*m)
+//            'hash' takes a const T& and must give equal hashes
+//            for values equal by T::operator==()
+// Note     : the modified *this (the result) will
+//            contain COPIES of duplicate values found
+//            in 'a', so 'a' and its values can be
+//            freed without damaging the result
+//            the COPIES WILL BE MADE using T::operator=()
+template <class T> template <class H>
+void dllist<T>::Union(const dllist<T> &a, H hash)
+{
+    if( !length )                       // if *this has no nodes
+    {                                   // just copy every node in 'a'
+        copy(a);
+        return;
+    } // if
+
+    if( a.length && &a != this )        // otherwise, verify 'a' has nodes
+    {                                   //  and copy over the unqine ones
+        auto hash_of = [&hash](T *v) { return (size_t)hash(*v); };
+        auto same    = [](T *v, T *w) { return *v == *w; };
+        std::unordered_set<T *, decltype(hash_of), decltype(same)>
+            have(length + a.length, hash_of, same);
+        for(cdllit<T> i(*this); !i.finished(); ++i)
+            have.insert(i());
+
+        dllitem<T> *tmp = a.head;
+        do
+        {   if( !have.count(tmp->value) )
+            {
+                T *another = new T;
+                *another = *tmp->value;
+                assert( add(another) );
+                have.insert(another);
+            } // if
+            tmp = tmp->next;
+        } while( tmp != a.head );
+    } // if
+} // template dllist<T>::Union(const dllist<T> &, H)
+
+
 // Template : void dllist<T>::sort(void)
-// Purpose  : sorts the list by sequentially comparing
-//            each node with T::operator<(const T *)
+// Purpose  : sorts the list greatest-to-least comparing
+//            nodes with T::operator<(const T *)
 //            this is a special routine which type T
 //            must have in order to use this procedure
 //            operator<() is expected to return a bool
@@ -318,49 +437,12 @@ void dllist<T>::Union(const dllist<T> &a)
 // Note1    : list node values will be NULL checked before
 //            attempting use of operator<(), if a nodes
 //            value is 0, it is treated as least in list
-// Note2    : the algorithm runs in time N^2-2N+2 or O(N^2)
-//            at its worst case (when elements start in
-//            reverse order), but is O(N) in the best case
+// Note2    : see merge_sort(), O(N log N) at its worst case,
+//            O(N) when the list is already (or reverse) ordered
 template <class T> uint dllist<T>::sort(void)
 {
-    if( !length )     // if *this has no nodes
-        return 0;     //  there's nothing to do
-
-    uint comparisons = 0;
-
-    dllitem<T> *steper = head;
-    while( steper != head->prior )
-    {
-        // perform initial comparison of steped-to node
-        //  and the node after it
-        comparisons++;
-        if( lessthan_opr(steper, steper->next) )
-        {
-            // exhange positions of the node steper points
-            //  to and the node after it
-            swap( steper );
-
-            // assign pointer for the nested loop
-            dllitem<T> *swaper = steper->prior;
-
-            // nested loop
-            // swap swaper back until '<' true
-            while( swaper != head )
-            {
-                comparisons++;
-                bool lesstrue = lessthan_opr(swaper, swaper->prior);
-
-                if( !lesstrue )
-                    swap( swaper->prior );
-                else  // jump from loop as soon as
-                    break;  // lessthan_opr() true
-            } // while
-        } // if
-        else // increment comparison node
-            steper = steper->next;
-    } // while
-
-    return comparisons;
+    return merge_sort( [this](const dllitem<T> *a, const dllitem<T> *b)
+                       { return lessthan_opr(a, b); } );
 } // template dllist<T>::sort()
 
 
@@ -375,10 +457,10 @@ template <class T> bool dllist<T>::lessthan_opr
     if( !a->value && !b->value )
         return false;  // a == b
 
-    if( !a )
+    if( !a->value )
         return true;   // a < b
 
-    if( !b )
+    if( !b->value )
         return false;  // a > b
 
     return *a->value < *b->value;
@@ -386,8 +468,8 @@ template <class T> bool dllist<T>::lessthan_opr
 
 
 // Template : void dllist<T>::sort_dll(void)
-// Purpose  : sorts the list by sequentially comparing
-//            each node with T::dll_lessthan(const T *)
+// Purpose  : sorts the list greatest-to-least comparing
+//            nodes with T::dll_lessthan(const T *)
 //            this is a special routine which type T
 //            must have in order to use this procedure
 //            dll_lessthan() is expected to return a bool
@@ -396,49 +478,12 @@ template <class T> bool dllist<T>::lessthan_opr
 // Note1    : list node values will be NULL checked before
 //            attempting use of dll_lessthan(), if a nodes
 //            value is 0, it is treated as least in list
-// Note2    : the algorithm runs in time N^2-2N+2 or O(N^2)
-//            at its worst case (when elements start in
-//            reverse order), but is O(N) in the best case
+// Note2    : see merge_sort(), O(N log N) at its worst case,
+//            O(N) when the list is already (or reverse) ordered
 template <class T> uint dllist<T>::sort_dll(void)
 {
-    if( !length )     // if *this has no nodes
-        return 0;     //  there's nothing to do
-
-    uint comparisons = 0;
-
-    dllitem<T> *steper = head;
-    while( steper != head->prior )
-    {
-        // perform initial comparison of steped-to node
-        //  and the node after it
-        comparisons++;
-        if( lessthan_dll(steper, steper->next) )
-        {
-            // exhange positions of the node steper points
-            //  to and the node after it
-            swap( steper );
-
-            // assign pointer for the nested loop
-            dllitem<T> *swaper = steper->prior;
-
-            // nested loop
-            // swap swaper back until '<' true
-            while( swaper != head )
-            {
-                comparisons++;
-                bool lesstrue = lessthan_dll(swaper, swaper->prior);
-
-                if( !lesstrue )
-                    swap( swaper->prior );
-                else  // jump from loop as soon as
-                    break;  // lessthan_dll() true
-            } // while
-        } // if
-        else // increment comparison node
-            steper = steper->next;
-    } // while
-
-    return comparisons;
+    return merge_sort( [this](const dllitem<T> *a, const dllitem<T> *b)
+                       { return lessthan_dll(a, b); } );
 } // template dllist<T>::sort_dll()
 
 
@@ -453,10 +498,10 @@ template <class T> bool dllist<T>::lessthan_dll
     if( !a->value && !b->value )
         return false;  // a == b
 
-    if( !a )
+    if( !a->value )
         return true;   // a < b
 
-    if( !b )
+    if( !b->value )
         return false;  // a > b
 
     return a->value->dll_lessthan(b->value);
@@ -464,8 +509,8 @@ template <class T> bool dllist<T>::lessthan_dll
 
 
 // Template : void dllist<T>::sort(bool (*)())
-// Purpose  : Sorts the list by sequentially comparing
-//            each node with the comparison functoin,
+// Purpose  : Sorts the list greatest-to-least comparing
+//            nodes with the comparison functoin,
 //            passed as the argument.
 //            The function pointed to by 'lt', must
 //            return a bool, and take two T*.
@@ -473,50 +518,13 @@ template <class T> bool dllist<T>::lessthan_dll
 // Note1    : list node values will be NULL checked before
 //            attempting use of lt(), if a nodes
 //            value is 0, it is treated as least in list
-// Note2    : the algorithm runs in time N^2-2N+2 or O(N^2)
-//            at its worst case (when elements start in
-//            reverse order), but is O(N) in the best case
+// Note2    : see merge_sort(), O(N log N) at its worst case,
+//            O(N) when the list is already (or reverse) ordered
 template <class T>
 uint dllist<T>::sort(bool (*lt)(const T *, const T *))
 {
-    if( !length )     // if *this has no nodes
-        return 0;     //  there's nothing to do
-
-    uint comparisons = 0;
-
-    dllitem<T> *steper = head;
-    while( steper != head->prior )
-    {
-        // perform initial comparison of steped-to node
-        //  and the node after it
-        comparisons++;
-        if( lessthan(steper, steper->next, lt) )
-        {
-            // exhange positions of the node steper points
-            //  to and the node after it
-            swap( steper );
-
-            // assign pointer for the nested loop
-            dllitem<T> *swaper = steper->prior;
-
-            // nested loop
-            // swap swaper back until '<' true
-            while( swaper != head )
-            {
-                comparisons++;
-                bool lesstrue = lessthan(swaper, swaper->prior, lt);
-
-                if( !lesstrue )
-                    swap( swaper->prior );
-                else  // jump from loop as soon as
-                    break;  // lessthan() true
-            } // while
-        } // if
-        else // increment comparison node
-            steper = steper->next;
-    } // while
-
-    return comparisons;
+    return merge_sort( [this, lt](const dllitem<T> *a, const dllitem<T> *b)
+                       { return lessthan(a, b, lt); } );
 } // template dllist<T>::sort(bool (*))
 
 
@@ -532,30 +540,292 @@ template <class T> bool dllist<T>::lessthan
     if( !a->value && !b->value )
         return false;  // a == b
 
-    if( !a )
+    if( !a->value )
         return true;   // a < b
 
-    if( !b )
+    if( !b->value )
         return false;  // a > b
 
     return (*lt)(a->value, b->value);
 } // dllist<T>::lessthan
 
 
-// Template : void dllist<T>::swap(ptr)
-// Purpose  : swaps list positions of 'ptr' and 'ptr->next'
-template <class T> void dllist<T>::swap(dllitem<T> *ptr)
+// Template : uint dllist<T>::merge_sort(LT lt)
+// Purpose  : stable natural merge sort of the list, greatest-to-least,
+//            'lt(a,b)' must return true if node 'a' is less than node 'b'
+//            the ring is opened into a 0 terminated chain on the next
+//            pointers, which is cut into runs already in order (a run
+//            in strictly reverse order is flipped in place), each run
+//            is carried up through runs[] like a binary counter so only
+//            runs of similar size are merged, then the prior pointers
+//            and the ring are restored in one last pass
+//            nodes are only relinked, no node or value is allocated
+// Returns  : number of comparisons performed for sort
+// Note     : O(N log R) for R runs, so O(N log N) at its worst case,
+//            and N-1 comparisons for a list that is already sorted,
+//            a sorted list with a few nodes add()ed on its end costs
+//            little more than merging those few nodes in
+template <class T> template <class LT>
+uint dllist<T>::merge_sort(LT lt)
 {
-    if( head == ptr )        // check if head needs
-        head = ptr->next;    //  reseting
-    dllitem<T> *tmp   = ptr->prior;
-    tmp->next         = ptr->next;
-    ptr->prior        = ptr->next;
-    ptr->next         = ptr->next->next;
-    ptr->prior->next  = ptr;
-    ptr->prior->prior = tmp;
-    ptr->next->prior  = ptr;
-} // dllist<T>::swap
+    detach();  // the nodes are about to change
+    if( length < 2 )  // if *this has less than 2 nodes
+        return 0;     //  there's nothing to do
+
+    uint comparisons = 0;
+
+    dllitem<T> *runs[DLL_SORT_LEVELS];  // runs[k] is the merge of 2^k runs, or 0
+    uint levels = 0;                    // number of runs[] in use
+
+    head->prior->next = 0;  // open the ring
+    dllitem<T> *rest  = head;
+    while( rest )
+    {
+        // peel the next natural run off the front of rest
+        dllitem<T> *run = rest, *tail = rest;
+        rest = rest->next;
+        if( rest )
+        {
+            comparisons++;
+            if( lt(tail, rest) )
+            {   // strictly ascending, so collect it reversed
+                tail->next = 0;
+                do
+                {   dllitem<T> *tmp = rest->next;
+                    rest->next = run;
+                    run        = rest;
+                    rest       = tmp;
+                } while( rest && (++comparisons, lt(run, rest)) );
+            } // if
+            else
+            {   // greatest-to-least already, equal nodes stay in order
+                do
+                {   tail = rest;
+                    rest = rest->next;
+                } while( rest && (++comparisons, !lt(tail, rest)) );
+                tail->next = 0;
+            } // else
+        } // if
+
+        // carry the run up, every runs[k] holds nodes from before 'run'
+        uint k = 0;
+        for(; k < levels && runs[k]; k++)
+        {
+            run     = merge_chains(runs[k], run, lt, comparisons);
+            runs[k] = 0;
+        } // for
+        if( k == levels ) levels++;
+        runs[k] = run;
+    } // while
+
+    // merge what's left, higher levels hold the earlier nodes
+    dllitem<T> *sorted = 0;
+    for(uint k = 0; k < levels; k++)
+        if( runs[k] )
+            sorted = sorted ? merge_chains(runs[k], sorted, lt, comparisons) : runs[k];
+
+    close_chain(sorted);
+    return comparisons;
+} // template dllist<T>::merge_sort()
+
+
+// Template : dllitem<T> *dllist<T>::merge_chains(a, b, lt, comparisons)
+// Purpose  : merges two 0 terminated, greatest-to-least chains,
+//            linked on next pointers only, into one chain
+//            on equal nodes 'a' goes first, so 'a' must hold
+//            the nodes that came earlier in the list to keep
+//            the sort stable
+// Returns  : head of the merged chain
+template <class T> template <class LT>
+dllitem<T> *dllist<T>::merge_chains(dllitem<T> *a, dllitem<T> *b,
+                                    LT &lt, uint &comparisons)
+{
+    dllitem<T> *merged = 0, **tail = &merged;
+    while( a && b )
+    {
+        comparisons++;
+        if( lt(a, b) )
+        {   *tail = b;  // b is greater, it goes first
+            tail  = &b->next;
+            b     = b->next;
+        } // if
+        else
+        {   *tail = a;
+            tail  = &a->next;
+            a     = a->next;
+        } // else
+    } // while
+    *tail = a ? a : b;  // hang whatever remains on the end
+    return merged;
+} // template dllist<T>::merge_chains()
+
+
+// Template : void dllist<T>::close_chain(dllitem<T> *first)
+// Purpose  : makes the 0 terminated chain of nodes linked on
+//            next pointers from 'first' the list's ring, restoring
+//            the prior pointers, 'first' becomes the head
+// Note     : the chain must hold every node of the list
+template <class T> void dllist<T>::close_chain(dllitem<T> *first)
+{
+    head = first;
+    dllitem<T> *prior = head;
+    for(dllitem<T> *tmp = head->next; tmp; tmp = tmp->next)
+    {
+        tmp->prior = prior;
+        prior      = tmp;
+    } // for
+    prior->next = head;
+    head->prior = prior;
+    changed();
+} // template dllist<T>::close_chain()
+
+
+// Template : uint dllist<T>::sort(LT lt)
+// Purpose  : sorts the list greatest-to-least comparing
+//            values with 'lt', any callable taking two T*
+//            and returning true if the first is less, a lambda
+//            or functor is called directly, so it can be inlined
+//            where sort(bool (*)()) calls through a pointer
+// Returns  : number of comparisons performed for sort
+// Note     : a 0 value is treated as least in list
+//            see merge_sort()
+template <class T> template <class LT>
+uint dllist<T>::sort(LT lt)
+{
+    return merge_sort( [&lt](const dllitem<T> *a, const dllitem<T> *b)
+                       {   if( !a->value || !b->value )
+                               return !a->value && b->value != 0;
+                           return (bool) lt(a->value, b->value); } );
+} // template dllist<T>::sort(LT)
+
+
+// Template : uint dllist<T>::sort_by_key(KF key)
+// Purpose  : sorts the list greatest-to-least by key(T*), where
+//            key() is any callable giving a value comparable with <,
+//            key() is called once per node and the keys are sorted
+//            in an array beside their nodes, so an expensive compare
+//            or a key reached through several pointers is paid for
+//            once per node, not once per comparison
+//            the sort is stable, and the nodes are then relinked
+// Returns  : number of comparisons performed for sort
+// Note     : nodes with a 0 value are least, and are not given to key()
+template <class T> template <class KF>
+uint dllist<T>::sort_by_key(KF key)
+{
+    detach();
+    if( length < 2 ) return 0;
+
+    typedef typename std::decay<decltype(key((T *)0))>::type K;
+    struct keyed { K key; dllitem<T> *node; };
+    std::vector<keyed>        keys;
+    std::vector<dllitem<T> *> nulls;
+    keys.reserve(length);
+
+    dllitem<T> *tmp = head;
+    for(uint i = length; i--; tmp = tmp->next)
+        if( tmp->value ) keys.push_back( keyed{ key(tmp->value), tmp } );
+        else nulls.push_back(tmp);
+
+    uint comparisons = 0;
+    std::stable_sort(keys.begin(), keys.end(),
+                     [&comparisons](const keyed &a, const keyed &b)
+                     { comparisons++; return b.key < a.key; } );
+
+    // chain the nodes in their new order, 0 values last
+    dllitem<T> *first = 0, **tail = &first;
+    for(size_t k = 0; k < keys.size(); k++)
+    {   *tail = keys[k].node;
+        tail  = &keys[k].node->next;
+    } // for
+    for(size_t k = 0; k < nulls.size(); k++)
+    {   *tail = nulls[k];
+        tail  = &nulls[k]->next;
+    } // for
+    *tail = 0;
+    close_chain(first);
+
+    return comparisons;
+} // template dllist<T>::sort_by_key()
+
+
+// Template : uint dllist<T>::radix_sort(KF key, bool ascending)
+// Purpose  : sorts the list by key(T*), an 8, 16, 32 or 64 bit integer
+//            or a 32 or 64 bit IEEE float, greatest-to-least as the
+//            other sorts do, or least-to-greatest if 'ascending'
+//            key() is called once per node, the keys are mapped by
+//            dllradix<K> onto unsigned integers and the (key, node)
+//            pairs are LSD radix sorted a byte per pass, between two
+//            arrays, then the nodes are relinked in their new order
+//            a pass is skipped if every key has the same byte there,
+//            so small keys in a wide type cost only the passes needed
+// Returns  : number of radix passes made, 0 to sizeof(key)
+// Note     : O(N) for each pass, and stable, nodes with equal keys
+//            stay in order whichever way the list is sorted
+//            nodes with a 0 value are least, and are not given to key()
+template <class T> template <class KF>
+uint dllist<T>::radix_sort(KF key, bool ascending)
+{
+    detach();
+    if( length < 2 ) return 0;
+
+    typedef typename std::decay<decltype(key((T *)0))>::type K;
+    struct keyed { unsigned long long key; dllitem<T> *node; };
+    std::vector<keyed>        keys, spare;
+    std::vector<dllitem<T> *> nulls;
+    keys.reserve(length);
+
+    // descending order is ascending order of the complemented keys,
+    //  which keeps equal keys stable
+    const unsigned long long flip = ascending ? 0ULL : ~0ULL;
+    dllitem<T> *tmp = head;
+    for(uint i = length; i--; tmp = tmp->next)
+        if( tmp->value ) keys.push_back( keyed{ dllradix<K>::bits(key(tmp->value)) ^ flip, tmp } );
+        else nulls.push_back(tmp);
+    if( keys.empty() ) return 0;  // only 0 values, the order stands
+    spare.resize(keys.size());
+
+    uint passes = 0;
+    const size_t n = keys.size();
+    for(uint shift = 0; shift < sizeof(K) * 8; shift += 8)
+    {
+        size_t count[256] = { 0 };
+        for(size_t k = 0; k < n; k++)
+            count[(keys[k].key >> shift) & 0xFF]++;
+        if( count[keys[0].key >> shift & 0xFF] == n ) continue;  // every key has this byte
+
+        size_t at = 0;  // turn the counts into bucket starts
+        for(uint b = 0; b < 256; b++)
+        {   size_t c = count[b];
+            count[b] = at;
+            at      += c;
+        } // for
+        for(size_t k = 0; k < n; k++)
+            spare[count[(keys[k].key >> shift) & 0xFF]++] = keys[k];
+        keys.swap(spare);
+        passes++;
+    } // for
+
+    // chain the nodes in their new order, 0 values are least
+    dllitem<T> *first = 0, **tail = &first;
+    if( ascending )
+        for(size_t k = 0; k < nulls.size(); k++)
+        {   *tail = nulls[k];
+            tail  = &nulls[k]->next;
+        } // for
+    for(size_t k = 0; k < n; k++)
+    {   *tail = keys[k].node;
+        tail  = &keys[k].node->next;
+    } // for
+    if( !ascending )
+        for(size_t k = 0; k < nulls.size(); k++)
+        {   *tail = nulls[k];
+            tail  = &nulls[k]->next;
+        } // for
+    *tail = 0;
+    close_chain(first);
+
+    return passes;
+} // template dllist<T>::radix_sort()
 
 
 // Template : dllist<T>::operator==(const dllist<T> &a)
@@ -615,6 +885,7 @@ bool dllist<T>::identical(const dllist<T> &a) const
 //            new legnth of list otherwise
 template <class T> uint dllist<T>::add(T *newvalue)
 {
+    detach();
     dllitem<T> *tmp = new dllitem<T>(newvalue);
     if( !tmp ) return( 0 ); // memory allocation failed
     if( length == 0 )
@@ -629,6 +900,8 @@ template <class T> uint dllist<T>::add(T *newvalue)
         tmp->next         = head;
     } // else
     head->prior = tmp;  // set the rear to the new end
+    indexed(tmp);
+    appended(tmp);
     return ++length;
 }  // template dllist<T>::add()
 
@@ -641,6 +914,7 @@ template <class T> uint dllist<T>::add(T *newvalue)
 //            new legnth of list otherwise
 template <class T> uint dllist<T>::add_copy(const T& newvalue)
 {
+    detach();
     dllitem<T> *tmp = new dllitem<T>(newvalue);
     if( !tmp ) return( 0 ); // memory allocation failed
     if( length == 0 )
@@ -655,6 +929,8 @@ template <class T> uint dllist<T>::add_copy(const T& newvalue)
         tmp->next         = head;
     } // else
     head->prior = tmp;  // set the rear to the new end
+    indexed(tmp);
+    appended(tmp);
     return ++length;
 }  // template dllist<T>::add_copy()
 
@@ -671,6 +947,7 @@ template <class T> uint dllist<T>::push(T *newvalue)
     //  just the same as adding to its end, we just
     //  reset the head pointer after adding
     head = head->prior;
+    changed();
     return length;
 }  // template dllist<T>::push()
 
@@ -689,6 +966,7 @@ template <class T> uint dllist<T>::push(T *newvalue)
 template <class T>
 uint dllist<T>::add_num(T *newvalue, uint num)
 {
+    detach();
     dllitem<T> *tmp = new dllitem<T>(newvalue);
     if( !tmp ) return( 0 ); // memory allocation failed
     if( length == 0 )
@@ -703,13 +981,12 @@ uint dllist<T>::add_num(T *newvalue, uint num)
         head->prior->next = tmp;
         tmp->next         = head;
         head->prior       = tmp;  // set new rear
+        appended(tmp);
     } // if
     else 
     { // add at num-th position
-        // iterate to the num-th node
-        dllitem<T> *old = head;
-        for(uint i = 0; i < num; i++)
-            old = old->next;
+        // find the num-th node
+        dllitem<T> *old = node_num(num);
         if( old == head ) head = tmp;
         // reassign pointers, to add
         //  newvalue before old
@@ -717,7 +994,12 @@ uint dllist<T>::add_num(T *newvalue, uint num)
         tmp->prior       = old->prior;
         old->prior       = tmp;
         tmp->next        = old;
+        // nodes after num moved down, but the new
+        //  node is a good place to start the next search
+        changed();
+        set_cursor(tmp, num);
     } // if
+    indexed(tmp);
     return ++length;
 }  // template dllist<T>::add_num()
 
@@ -730,6 +1012,18 @@ uint dllist<T>::add_num(T *newvalue, uint num)
 template <class T>
 bool dllist<T>::remove(const T *oldvalue)
 {
+    detach();
+    if( index() )
+    {   bool many;
+        dllitem<T> *n = dllindex<T>::sole(index()->by_ptr, oldvalue,
+                                          [](const dllitem<T> *) { return true; }, many);
+        if( !many )
+        {   if( !n ) return false;  // oldvalue isn't in the list
+            drop_node(n);
+            return true;
+        } // if
+    } // if  duplicates of oldvalue, search for the first
+
     if( length )
     {   dllit<T> i(*this);
         do
@@ -756,6 +1050,19 @@ bool dllist<T>::remove(const T *oldvalue)
 template <class T>
 bool dllist<T>::remove_delete(T *oldvalue)
 {
+    detach();
+    if( index() )
+    {   bool many;
+        dllitem<T> *n = dllindex<T>::sole(index()->by_ptr, (const T *)oldvalue,
+                                          [](const dllitem<T> *) { return true; }, many);
+        if( !many )
+        {   if( !n ) return false;  // oldvalue isn't in the list
+            drop_node(n);
+            delete oldvalue;
+            return true;
+        } // if
+    } // if  duplicates of oldvalue, search for the first
+
     if( length )
     {   dllit<T> i(*this);
         do
@@ -783,6 +1090,19 @@ bool dllist<T>::remove_delete(T *oldvalue)
 template <class T>
 bool dllist<T>::remove(const T& oldvalue)
 {
+    detach();
+    if( index() && index()->hash )
+    {   bool many;
+        dllitem<T> *n = dllindex<T>::sole(index()->by_hash, index()->hash(oldvalue),
+                                          [&oldvalue](const dllitem<T> *n) { return *n->value == oldvalue; },
+                                          many);
+        if( !many )
+        {   if( !n ) return false;  // oldvalue isn't in the list
+            drop_node(n);
+            return true;
+        } // if
+    } // if  more than one equal to oldvalue, search for the first
+
     if( length )
     {   dllit<T> i(*this);
         do
@@ -808,6 +1128,21 @@ bool dllist<T>::remove(const T& oldvalue)
 template <class T>
 bool dllist<T>::remove_delete(const T& oldvalue)
 {
+    detach();
+    if( index() && index()->hash )
+    {   bool many;
+        dllitem<T> *n = dllindex<T>::sole(index()->by_hash, index()->hash(oldvalue),
+                                          [&oldvalue](const dllitem<T> *n) { return *n->value == oldvalue; },
+                                          many);
+        if( !many )
+        {   if( !n ) return false;  // oldvalue isn't in the list
+            T *found = n->value;
+            drop_node(n);
+            delete found;
+            return true;
+        } // if
+    } // if  more than one equal to oldvalue, search for the first
+
     if( length )
     {   dllit<T> i(*this);
         do
@@ -834,13 +1169,12 @@ bool dllist<T>::remove_delete(const T& oldvalue)
 template <class T>
 bool dllist<T>::remove_num(uint num)
 {
+    detach();
     if( !length || num < 0 || num >= length )
         return false;  // out of bounds
 
-    // iterate to num-th position
-    dllitem<T> *tmp = head;
-    for(uint i = 0; i < num; i++)
-        tmp = tmp->next;
+    // find num-th node
+    dllitem<T> *tmp = node_num(num);
 
     // reassign pointers to remove tmp
     tmp->prior->next = tmp->next;
@@ -848,6 +1182,12 @@ bool dllist<T>::remove_num(uint num)
     // check if head is being removed
     if( head == tmp )
         head = tmp->next;
+    // nodes after num moved up, the one that
+    //  took num's place is where to start next
+    changed();
+    if( num < length - 1 )
+        set_cursor(tmp->next, num);
+    unindexed(tmp);
     delete tmp; // delete old node
 
     length--;
@@ -864,13 +1204,12 @@ bool dllist<T>::remove_num(uint num)
 template <class T>
 bool dllist<T>::remove_num_delete(uint num)
 {
+    detach();
     if( !length || num < 0 || num >= length )
         return false;  // out of bounds
 
-    // iterate to num-th position
-    dllitem<T> *tmp = head;
-    for(uint i = 0; i < num; i++)
-        tmp = tmp->next;
+    // find num-th node
+    dllitem<T> *tmp = node_num(num);
 
     // reassign pointers to remove tmp
     tmp->prior->next = tmp->next;
@@ -878,6 +1217,12 @@ bool dllist<T>::remove_num_delete(uint num)
     // check if head is being removed
     if( head == tmp )
         head = tmp->next;
+    // nodes after num moved up, the one that
+    //  took num's place is where to start next
+    changed();
+    if( num < length - 1 )
+        set_cursor(tmp->next, num);
+    unindexed(tmp);
     delete tmp->value;     // delete T object
     delete tmp;            // delete old node
 
@@ -894,6 +1239,7 @@ bool dllist<T>::remove_num_delete(uint num)
 template <class T>
 bool dllist<T>::remove_last(void)
 {
+    detach();
     // nothing to remove?
     if( length == 0 ) return false;
 
@@ -901,6 +1247,12 @@ bool dllist<T>::remove_last(void)
     dllitem<T> *tmp  = head->prior;
     tmp->prior->next = head;
     head->prior      = tmp->prior;  // set the rear node
+    if( dllext<T> *x = extension() )  // no other position moved
+    {   if( x->cursor.at() == tmp ) x->cursor.clear();
+        dllskip<T> *s = x->skip;
+        if( s && s->nodes && s->nodes[s->count - 1] == tmp ) s->drop();
+    } // if
+    unindexed(tmp);
     delete tmp;                     // free link node
 
     length--;
@@ -916,6 +1268,7 @@ bool dllist<T>::remove_last(void)
 template <class T>
 bool dllist<T>::remove_last_delete(void)
 {
+    detach();
     // nothing to remove?
     if( length == 0 ) return false;
 
@@ -923,6 +1276,12 @@ bool dllist<T>::remove_last_delete(void)
     dllitem<T> *tmp  = head->prior;
     tmp->prior->next = head;
     head->prior      = tmp->prior;  // set the rear node
+    if( dllext<T> *x = extension() )  // no other position moved
+    {   if( x->cursor.at() == tmp ) x->cursor.clear();
+        dllskip<T> *s = x->skip;
+        if( s && s->nodes && s->nodes[s->count - 1] == tmp ) s->drop();
+    } // if
+    unindexed(tmp);
     delete tmp->value;              // free T object
     delete tmp;                     // free link node
 
@@ -937,6 +1296,7 @@ bool dllist<T>::remove_last_delete(void)
 //            FALSE if there was nothing in the list
 template <class T> bool dllist<T>::pop(void)
 {
+    detach();
     // nothing to remove?
     if( length == 0 ) return false;
 
@@ -945,6 +1305,8 @@ template <class T> bool dllist<T>::pop(void)
     head->next->prior = head->prior;  // set the rear node
     dllitem<T> *tmp   = head;
     head              = head->next;   // reset head node
+    changed();
+    unindexed(tmp);
     delete tmp;                       // free link node
 
     length--;
@@ -959,6 +1321,7 @@ template <class T> bool dllist<T>::pop(void)
 //            FALSE if there was nothing in the list
 template <class T> bool dllist<T>::pop_delete(void)
 {
+    detach();
     // nothing to remove?
     if( length == 0 ) return false;
 
@@ -967,6 +1330,8 @@ template <class T> bool dllist<T>::pop_delete(void)
     head->next->prior = head->prior;  // set the rear node
     dllitem<T> *tmp   = head;
     head              = head->next;   // reset head node
+    changed();
+    unindexed(tmp);
     delete tmp->value;                // free T object
     delete tmp;                       // free link node
 
@@ -980,9 +1345,12 @@ template <class T> bool dllist<T>::pop_delete(void)
 //            comparing pointer values, not references
 // Returns  : true  if 'a' is found
 //            false if 'a' is not found
+// Note     : O(1) once index_members() is called
 template <class T>
 bool dllist<T>::in_list(const T *a) const
 {
+    if( index() ) return index()->by_ptr.count(a) != 0;
+
     if( length )
         for(cdllit<T> i(*this); !i.finished(); ++i)
             if( i() == a ) return true;
@@ -999,6 +1367,13 @@ bool dllist<T>::in_list(const T *a) const
 template <class T>
 T *dllist<T>::ref_in_list(const T &a) const
 {
+    if( index() && index()->hash )
+    {   bool many;
+        dllitem<T> *n = dllindex<T>::sole(index()->by_hash, index()->hash(a),
+                                          [&a](const dllitem<T> *n) { return *n->value == a; }, many);
+        if( !many ) return n ? n->value : 0;
+    } // if  more than one equal to 'a', search for the first
+
     if( length )
         for(cdllit<T> i(*this); !i.finished(); ++i)
             if( *i() == a ) return i();
@@ -1015,6 +1390,13 @@ T *dllist<T>::ref_in_list(const T &a) const
 template <class T>
 T *dllist<T>::match_in_list(const string& str) const
 {
+    if( index() && index()->str_key )
+    {   bool many;
+        dllitem<T> *n = dllindex<T>::sole(index()->by_str, str,
+                                          [&str](const dllitem<T> *n) { return n->value->matches(str); }, many);
+        if( !many ) return n ? n->value : 0;
+    } // if  more than one match, search for the first
+
     if( length )
         for(cdllit<T> i(*this); !i.finished(); ++i)
             if( i()->matches(str) ) return i();
@@ -1047,6 +1429,13 @@ T *dllist<T>::match_in_list(const string& str1, const string& str2) const
 template <class T>
 T *dllist<T>::match_in_list(const int num) const
 {
+    if( index() && index()->num_key )
+    {   bool many;
+        dllitem<T> *n = dllindex<T>::sole(index()->by_num, (long)num,
+                                          [num](const dllitem<T> *n) { return n->value->matches(num); }, many);
+        if( !many ) return n ? n->value : 0;
+    } // if  more than one match, search for the first
+
     if( length )
         for(cdllit<T> i(*this); !i.finished(); ++i)
             if( i()->matches(num) ) return i();
@@ -1063,6 +1452,13 @@ T *dllist<T>::match_in_list(const int num) const
 template <class T>
 T *dllist<T>::match_in_list(const uint num) const
 {
+    if( index() && index()->num_key )
+    {   bool many;
+        dllitem<T> *n = dllindex<T>::sole(index()->by_num, (long)num,
+                                          [num](const dllitem<T> *n) { return n->value->matches(num); }, many);
+        if( !many ) return n ? n->value : 0;
+    } // if  more than one match, search for the first
+
     if( length )
         for(cdllit<T> i(*this); !i.finished(); ++i)
             if( i()->matches(num) ) return i();
@@ -1091,14 +1487,12 @@ T *dllist<T>::match_in_list(const double num) const
 // Purpose: return reference to the ith element of the list
 //          reutrns 0 if i address beyond number of nodes
 //          i is assmued to be zero starting
+// Note   : const, but leaves the list's cursor at node i (see node_num())
 template <class T> T &dllist<T>::operator[](const uint i) const
 {
     if( length < 1 || i >= length || i < 0 ) return *(T *)0;
 
-    dllitem<T> *ptr = head;
-    for(uint j = 0; j < i; j++) ptr = ptr->next;
-
-    return *ptr->value;
+    return *node_num(i)->value;
 }  // template dllist<T>::operator[]()
 
 
@@ -1106,15 +1500,319 @@ template <class T> T &dllist<T>::operator[](const uint i) const
 // Purpose: return pointer to the ith element of the list
 //          reutrns 0 if i address beyond number of nodes
 //          i is assmued to be zero starting
+// Note   : const, but leaves the list's cursor at node i, as operator[]() does
 template <class T> T *dllist<T>::get_num(const uint i) const
 {
     if( length < 1 || i >= length || i < 0 ) return 0;
 
+    return node_num(i)->value;
+}  // template dllist<T>::get_num()
+
+
+// Template : dllitem<T> *dllist<T>::node_num(const uint) const
+// Purpose  : find the i-th node of the list, walking from whichever
+//            is closest of the head, the last node, the cursor (the
+//            node found by the last call) or the nearest skip index
+//            entry (if index_positions() was called), so positions
+//            taken in order cost O(1) each, and random positions
+//            cost O(step) with a skip index, O(length/4) without
+// Note     : i must be < length, the cursor is left at the found node
+// Note     : const methods call it, so several threads may at once,
+//            the cursor is a dllcursor, which a thread only takes when
+//            it is whole, and moves only when no other thread is, and the
+//            skip index is built by one thread, the others walk meanwhile
+template <class T> dllitem<T> *dllist<T>::node_num(const uint i) const
+{
+    // start from the head or the last node, whichever is nearer
     dllitem<T> *ptr = head;
-    for(uint j = 0; j < i; j++) ptr = ptr->next;
+    uint at = 0, dist = i;
+    if( length - 1 - i < dist )
+    {   ptr  = head->prior;
+        at   = length - 1;
+        dist = length - 1 - i;
+    } // if
+
+    // the cursor may be closer
+    dllext<T> *x = extension();
+    dllitem<T> *c;
+    uint        cn;
+    if( x && x->cursor.get(c, cn) )
+    {   uint d = i > cn ? i - cn : cn - i;
+        if( d < dist ) { ptr = c; at = cn; dist = d; }
+    } // if
+
+    // and so may the nearest skip index entry
+    dllskip<T> *s = skip();
+    dllitem<T> **nodes = 0;
+    if( s && dist > 1 && !(nodes = s->nodes.load(std::memory_order_acquire)) )
+        nodes = build_skip();
+    if( nodes )
+    {   uint k = (i + s->step / 2) / s->step;
+        if( k >= s->count ) k = s->count - 1;
+        uint d = i > k * s->step ? i - k * s->step : k * s->step - i;
+        if( d < dist ) { ptr = nodes[k]; at = k * s->step; dist = d; }
+    } // if
+    if( !dist ) return ptr;  // an end, the cursor or an index entry, so no need to move the cursor
+
+    // walk the rest of the way
+    for(; at < i; at++) ptr = ptr->next;
+    for(; at > i; at--) ptr = ptr->prior;
+
+    set_cursor(ptr, i);
+    return ptr;
+}  // template dllist<T>::node_num()
+
+
+// Template : dllitem<T> **dllist<T>::build_skip(void) const
+// Purpose  : fill the skip index with every step-th node,
+//            in one walk of the list
+// Returns  : the index's nodes, 0 if the list is empty, or another
+//            thread is building it, in which case the caller walks
+// Note     : the nodes are filled in a new array, which is stored to
+//            s->nodes last, after step and count, so a thread that
+//            loads s->nodes finds step and count to match
+template <class T> dllitem<T> **dllist<T>::build_skip(void) const
+{
+    dllskip<T> *s = skip();
+    if( s->building.test_and_set(std::memory_order_acquire) ) return 0;
+    dllitem<T> **nodes = s->nodes.load(std::memory_order_relaxed);
+    if( !nodes && length )  // no other thread built it meanwhile
+    {
+        s->step = s->want;
+        if( !s->step )  // about sqrt(length) nodes between entries
+            for(s->step = 1; s->step * s->step < length; s->step++) ;
+
+        s->count = (length - 1) / s->step + 1;
+        s->room  = s->count;
+        nodes    = new dllitem<T> *[s->room];
+
+        dllitem<T> *ptr = head;
+        for(uint k = 0; k < s->count; k++)
+        {
+            nodes[k] = ptr;
+            if( k + 1 < s->count )
+                for(uint j = 0; j < s->step; j++) ptr = ptr->next;
+        } // for
+        s->nodes.store(nodes, std::memory_order_release);
+    } // if
+    s->building.clear(std::memory_order_release);
+    return nodes;
+}  // template dllist<T>::build_skip()
+
+
+// Template : void dllskip<T>::append(dllitem<T> *n, uint pos)
+// Purpose  : index node 'n', just added at the end, list position
+//            'pos', if it falls on a step, so appending keeps the
+//            index whole, when the step was picked for the length,
+//            it is doubled once there are over twice that many
+//            entries, dropping every other one, so the index stays
+//            about sqrt(length) entries, at O(1) amortized per add
+template <class T> void dllskip<T>::append(dllitem<T> *n, uint pos)
+{
+    if( pos % step ) return;
+    if( count == room )
+    {   dllitem<T> **more = new dllitem<T> *[room * 2];
+        memcpy(more, nodes, count * sizeof(dllitem<T> *));
+        delete [] nodes;
+        nodes = more;
+        room *= 2;
+    } // if
+    nodes[count++] = n;
+
+    if( !want && count > 2 * step )
+    {   for(uint k = 1; 2 * k < count; k++)
+            nodes[k] = nodes[2 * k];
+        count = (count + 1) / 2;
+        step *= 2;
+    } // if
+}  // template dllskip<T>::append()
+
+
+// Template : void dllist<T>::index_members(str_key, num_key, hash)
+// Purpose  : start keeping a hash index of the list's nodes, always by
+//            value pointer, for in_list() and remove(const T*), and by
+//            each key function given:
+//              str_key - string for which T::matches(const string&) is
+//                        true, used by match_in_list(const string&)
+//              num_key - integer for which T::matches(int or uint) is
+//                        true, used by those two match_in_list()
+//              hash    - hash of a T, equal T's by T::operator==() must
+//                        hash alike, used by ref_in_list() and remove(const T&)
+//            the index is built from the current nodes, in O(size())
+// Note     : match_in_list(const string&, const string&) and
+//            match_in_list(const double) still search the list
+template <class T>
+void dllist<T>::index_members(string (*str_key)(const T *), long (*num_key)(const T *),
+                              size_t (*hash)(const T &))
+{
+    dllext<T> *x = extra();
+    delete x->index;
+    x->index = new dllindex<T>(str_key, num_key, hash);
+    dllitem<T> *tmp = head;
+    for(uint i = length; i--; tmp = tmp->next)
+        x->index->insert(tmp);
+}  // template dllist<T>::index_members()
+
+
+// Template : void dllist<T>::free_ring(dllitem<T> *, uint)
+// Purpose  : free the 'n' nodes of the ring starting at 'first',
+//            does NOT DELETE their values
+template <class T> void dllist<T>::free_ring(dllitem<T> *first, uint n)
+{
+#ifdef DLLIST_POOL_NODES
+    // nodes have trivial destructors, so the whole
+    //  ring can go back to the pool without a walk
+    dllpool<T>::pool().put_ring(first, n);
+#else
+    dllitem<T> *next;
+    while( n-- )
+    {
+        next = first->next;
+        delete first;
+        first = next;
+    } // while()
+#endif
+}  // template dllist<T>::free_ring()
+
+
+// Template : bool dllist<T>::release(void)
+// Purpose  : give up *this' claim on nodes shared with copies
+// Returns  : true -- the nodes are *this' own to free
+//            false -- a copy still holds them, leave them be
+template <class T> bool dllist<T>::release(void)
+{
+    std::atomic<uint> *shared = refs();
+    if( !shared ) return true;
+    bool last = shared->fetch_sub(1) == 1;
+    if( last ) delete shared;
+    extension()->refs = 0;
+    return last;
+}  // template dllist<T>::release()
+
+
+// Template : void dllist<T>::unshare(void)
+// Purpose  : give *this nodes of its own, in place of the nodes it
+//            shares with the copies made by operator=(), the values
+//            pointed to are not copied, only the nodes
+// Note     : called through detach() by every method that changes
+//            the nodes, so the first change to a shared list is O(size())
+//            and the copies it shared with do not see it
+//            gen is counted up, so the dllits and cdllits on *this
+//            find their positions again among the new nodes
+template <class T> void dllist<T>::unshare(void)
+{
+    std::atomic<uint> *shared = refs();
+    if( shared->load() == 1 )  // the copies are all gone
+    {   delete shared;
+        extension()->refs = 0;
+        return;
+    } // if
+
+    dllitem<T> *old = head;
+    uint n = length;
+    extension()->refs = 0; head = 0; length = 0;
+    if( index() ) index()->clear();
+    for(uint i = n; i--; old = old->next)
+        add(old->value);  // indexes the new nodes, too
+    if( shared->fetch_sub(1) == 1 )  // the copies let go meanwhile
+    {   free_ring(old, n);
+        delete shared;
+    } // if
+    changed();
+    gen++;
+}  // template dllist<T>::unshare()
 
-    return ptr->value;
-}  // template dllist<T>::get_num()
+
+// Template : dllext<T> *dllist<T>::extra(void) const
+// Purpose  : the list's dllext, made the first time it is needed
+// Note     : const, as a copy or a positional access needs one,
+//            so it is installed by compare and swap, and two threads
+//            making it at once get the same one
+template <class T> dllext<T> *dllist<T>::extra(void) const
+{
+    dllext<T> *x = extension();
+    if( !x )
+    {   dllext<T> *made = new dllext<T>;
+        if( ext.compare_exchange_strong(x, made) ) x = made;
+        else delete made;  // x is the other thread's
+    } // if
+    return x;
+}  // template dllist<T>::extra()
+
+
+// Template : void dllist<T>::drop_node(dllitem<T> *n)
+// Purpose  : unlink node 'n' found through the index
+//            and free it, does NOT DELETE its value
+template <class T> void dllist<T>::drop_node(dllitem<T> *n)
+{
+    unindexed(n);
+    if( length == 1 ) head = 0;
+    else
+    {   n->prior->next = n->next;
+        n->next->prior = n->prior;
+        if( head == n ) head = n->next;
+    } // else
+    changed();
+    delete n;
+    length--;
+}  // template dllist<T>::drop_node()
+
+
+// Template : void dllindex<T>::insert(dllitem<T> *n)
+// Purpose  : enter node 'n' under each of its keys
+template <class T> void dllindex<T>::insert(dllitem<T> *n)
+{
+    by_ptr.emplace(n->value, n);
+    if( !n->value ) return;
+    if( str_key ) by_str.emplace(str_key(n->value), n);
+    if( num_key ) by_num.emplace(num_key(n->value), n);
+    if( hash )    by_hash.emplace(hash(*n->value), n);
+}  // template dllindex<T>::insert()
+
+
+// Template : void dllindex<T>::erase(dllitem<T> *n)
+// Purpose  : remove node 'n' from under each of its keys,
+//            its value must not have been deleted yet
+template <class T> void dllindex<T>::erase(dllitem<T> *n)
+{
+    erase_from(by_ptr, (const T *)n->value, n);
+    if( !n->value ) return;
+    if( str_key ) erase_from(by_str, str_key(n->value), n);
+    if( num_key ) erase_from(by_num, num_key(n->value), n);
+    if( hash )    erase_from(by_hash, hash(*n->value), n);
+}  // template dllindex<T>::erase()
+
+
+// Template : void dllindex<T>::erase_from(m, key, n)
+// Purpose  : remove node 'n' from the nodes under 'key' in map 'm'
+template <class T> template <class M, class K>
+void dllindex<T>::erase_from(M &m, const K &key, dllitem<T> *n)
+{
+    auto r = m.equal_range(key);
+    for(auto it = r.first; it != r.second; ++it)
+        if( it->second == n ) { m.erase(it); return; }
+}  // template dllindex<T>::erase_from()
+
+
+// Template : dllitem<T> *dllindex<T>::sole(m, key, match, many)
+// Purpose  : look through the nodes under 'key' in map 'm' for
+//            one that passes 'match'
+// Returns  : the node, 0 if no node passed
+//            0 with 'many' set if more than one passed, then the
+//            caller must search the list for the first of them
+template <class T> template <class M, class K, class P>
+dllitem<T> *dllindex<T>::sole(const M &m, const K &key, P match, bool &many)
+{
+    dllitem<T> *found = 0;
+    many = false;
+    auto r = m.equal_range(key);
+    for(auto it = r.first; it != r.second; ++it)
+        if( match(it->second) )
+        {   if( found ) { many = true; return 0; }
+            found = it->second;
+        } // if
+    return found;
+}  // template dllindex<T>::sole()
 
 
 // Template : T *dllist<T>::rand(void)
@@ -1125,22 +1823,110 @@ template <class T> T *dllist<T>::get_num(const uint i) const
 //            seeded by srand() BEFORE calling rand()
 //            calling dllist<T>::seed() will seed it
 //            with the current microsecond
+// Note     : std::rand() is shared by the whole program, and not
+//            thread safe, rand(G&) draws from a RandGen instead
 // Returns  : pointer to value of randomly selected node
 //            0 if no nodes in list
 template <class T> T *dllist<T>::rand(void) const
 {
     if( !length ) return 0;  // saftey chk
 
-    long pick = std::rand() % length;
+    uint pick = std::rand() % length;
 
-    dllitem<T> *ptr = head;
-    for(long i = 0; i < pick; i++)
-        ptr = ptr->next;
+    return node_num(pick)->value;
+}  // template dllist<T>::rand()
 
-    return ptr->value;
+
+// Template : uint dllist<T>::draw(G &gen, uint n)
+// Purpose  : pick a number from 0 to n-1, uniformly, by gen, any
+//            RandGen (or class with its next_rand(), Start() and Range())
+//            built without odds, gen's draws are strung together until
+//            they span n, so this works whatever gen's range is
+// Note     : n must be > 0, the slight bias of the final % n is
+//            less than n/span, which is below 1/n once span >= n^2
+template <class T> template <class G>
+uint dllist<T>::draw(G &gen, uint n)
+{
+    unsigned long long range = gen.Range(), span = 1, r = 0;
+    if( range < 2 ) return 0;  // gen has only the one number to give
+    while( span < (unsigned long long) n * n && span <= ~0ULL / range )
+    {   r = r * range + (gen.next_rand() - gen.Start());
+        span *= range;
+    } // while
+    return r % n;
+}  // template dllist<T>::draw()
+
+
+// Template : T *dllist<T>::rand(G &gen) const
+// Purpose  : to return a randomly selected node value,
+//            picked by gen, a RandGen (see draw()), so no
+//            global generator state is touched, gen is the
+//            caller's, one per thread if threads pick
+// Returns  : pointer to value of randomly selected node
+//            0 if no nodes in list
+// Note     : the node is found by node_num(), so this is O(1)
+//            on a list with index_positions(1), O(step) with
+//            a coarser skip index, O(N) without any
+template <class T> template <class G>
+T *dllist<T>::rand(G &gen) const
+{
+    if( !length ) return 0;  // saftey chk
+    return node_num(draw(gen, length))->value;
 }  // template dllist<T>::rand()
 
 
+// Template : uint dllist<T>::sample(uint k, dllist<T> &out, G &gen) const
+// Purpose  : add k of *this' value pointers to the end of 'out',
+//            each k-set of nodes equally likely, picked by gen (see
+//            draw()) in one pass over *this by reservoir sampling
+// Returns  : number of values added, k or size() if less
+// Note     : the values come out in no particular order
+template <class T> template <class G>
+uint dllist<T>::sample(uint k, dllist<T> &out, G &gen) const
+{
+    if( k > length ) k = length;
+    if( !k ) return 0;
+    std::vector<T *> reservoir;
+    reservoir.reserve(k);
+    dllitem<T> *tmp = head;
+    for(uint i = 0; i < length; i++, tmp = tmp->next)
+    {
+        if( i < k ) reservoir.push_back(tmp->value);
+        else
+        {   uint j = draw(gen, i + 1);    // the i-th node stays with chance k/(i+1)
+            if( j < k ) reservoir[j] = tmp->value;
+        } // else
+    } // for
+    uint added = 0;
+    for(uint j = 0; j < k; j++)
+        if( out.add(reservoir[j]) ) added++;
+    return added;
+}  // template dllist<T>::sample()
+
+
+// Template : void dllist<T>::shuffle(G &gen)
+// Purpose  : put the nodes in a random order, each order equally
+//            likely, picked by gen (see draw()), the nodes are
+//            gathered into an array, Fisher-Yates shuffled there
+//            and relinked in their new order, in O(N)
+template <class T> template <class G>
+void dllist<T>::shuffle(G &gen)
+{
+    detach();
+    if( length < 2 ) return;
+    std::vector<dllitem<T> *> nodes(length);
+    dllitem<T> *tmp = head;
+    for(uint i = 0; i < length; i++, tmp = tmp->next)
+        nodes[i] = tmp;
+    for(uint i = length - 1; i; i--)
+        std::swap(nodes[i], nodes[draw(gen, i + 1)]);
+    for(uint i = 0; i + 1 < length; i++)
+        nodes[i]->next = nodes[i + 1];
+    nodes[length - 1]->next = 0;
+    close_chain(nodes[0]);
+}  // template dllist<T>::shuffle()
+
+
 // Template : T *dllist<T>::seed(void)
 // Purpose  : seeds the rand() (stdlib.h) number
 //            generator by the microseconds obtained
@@ -1183,6 +1969,7 @@ template <class T> void dllist<T>::seed(void) const
 //                  if(!remove_happened) ++i; }
 template <class T> uint dllit<T>::remove(void)
 {
+    own();
     // check for empty list
     if( !list.length ) return( 0 );
     // make holder of next node address
@@ -1193,6 +1980,8 @@ template <class T> uint dllit<T>::remove(void)
     // relink & free memory
     ptr->prior->next = ptr->next;
     ptr->next->prior = ptr->prior;
+    list.changed();
+    list.unindexed(ptr);
     delete ptr;
     ptr = tmp;
     // if list has been reduced to 0 length, then 0 pointers
@@ -1233,6 +2022,7 @@ template <class T> uint dllit<T>::remove(void)
 //                  if(!remove_happened) ++i; }
 template <class T> uint dllit<T>::remove_delete(void)
 {
+    own();
     // check for empty list
     if( !list.length ) return( 0 );
     // make holder of next node address
@@ -1243,6 +2033,8 @@ template <class T> uint dllit<T>::remove_delete(void)
     // relink & free memory
     ptr->prior->next = ptr->next;
     ptr->next->prior = ptr->prior;
+    list.changed();
+    list.unindexed(ptr);
     delete ptr->value;
     delete ptr;
     ptr = tmp;
@@ -1266,6 +2058,7 @@ template <class T> uint dllit<T>::remove_delete(void)
 // Notes    : iterator's position will be reset to compensate for remove
 template <class T> bool dllit<T>::remove(const T *oldvalue)
 {
+    own();
     if( list.length )
     {   dllit<T> j(list);
         do
@@ -1303,6 +2096,7 @@ template <class T> bool dllit<T>::remove(const T *oldvalue)
 // Notes    : iterator's position will be reset to compensate for remove
 template <class T> bool dllit<T>::remove_delete(T *oldvalue)
 {
+    own();
     if( list.length )
     {   dllit<T> j(list);
         do
@@ -1336,6 +2130,7 @@ template <class T> bool dllit<T>::remove_delete(T *oldvalue)
 template <class T>
 inline uint dllit<T>::add_before(T *a)
 {
+    own();
     return list.add_num(a, i++);
 } // template dllit<T>::add_before()
 
@@ -1348,6 +2143,7 @@ inline uint dllit<T>::add_before(T *a)
 template <class T>
 inline uint dllit<T>::add_after(T *a)
 {
+    own();
     return list.add_num(a, i + 1);
 } // template dllit<T>::add_after()
 
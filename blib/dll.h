@@ -28,6 +28,27 @@
 // 20160916 - rewrote dllist<T>::match2_in_list(const string&, const string&) as dllist<T>::match_in_list(const string&, const string&)
 //            since it a different signature than dllist<T>::match_in_list(const string&), duh!
 // 20160917 - added dllist<T>::match_in_list(const double&)
+// 20261017 - dllitem<T> nodes are now allocated from a dllpool<T> slab allocator (see DLLIST_POOL_NODES)
+// 20261017 - sort(), sort_dll() and sort(bool (*)()) are now a stable O(N log N) merge sort, swap() removed
+// 20261017 - added a last-access cursor and the optional index_positions() skip index for positional access,
+//            used by operator[](), get_num(), add_num(), remove_num() and the iterators' start_at()
+// 20261017 - added the citerator typedef, naming cdllit<T> for templates written for any blib list
+// 20261017 - added the optional index_members() hash index for in_list(), ref_in_list(), remove()
+//            and the string and integer match_in_list()
+// 20261017 - operator-=(), pUnion() and the new Union(const dllist<T>&, H) work through a hash set in O(n+m)
+// 20261017 - added parallel_sort() and parallel_sort_dll(), merge sorts run on blib::Thread workers
+// 20261017 - added sort(LT) for any callable less-than and sort_by_key(), which sorts on keys taken once per node
+// 20261017 - added radix_sort() for integer and floating point keys, with dllradix<K>
+// 20261017 - the copy constructor and operator=() share the argument's nodes, copy-on-write
+// 20261017 - added begin() and end(), dllstlit<T> standard bidirectional iterators for range-for and <algorithm>
+// 20261017 - added rand(G&), sample() and shuffle(), which draw from a RandGen rather than std::rand()
+// 20261017 - the cursor, the skip and hash indexes and the shared node count are kept in a dllext<T>,
+//            allocated when first used, so a plain dllist is three words, as it was two before them
+// 20261017 - the parallel sorts are declared here but defined in dllpsort.h, added parallel_sort(int)
+// 20261017 - added dllist<T>::gen, dllit<T> and cdllit<T> sync() to it, ext and dllext<T>::refs are atomic
+// 20261017 - begin() of an empty list is end(), head is left stale by the removers that empty it
+// 20261017 - the cursor is a dllcursor, and the skip index is built under a flag and published by an
+//            atomic, so const positional access is thread safe again
 
 
 #ifndef DOUBLELY_LINKED_LIST_TEMPLATE
@@ -35,8 +56,17 @@
 
 
 #include <string>
+#include <unordered_map>  // for dllindex<T>
+#include <unordered_set>  // for pUnion() and Union()
+#include <type_traits>    // for dllradix<K>
+#include <cstring>        // for memcpy()
+#include <atomic>         // for the shared node count
+#include <iterator>       // for std::bidirectional_iterator_tag
+#include <cstddef>        // for std::ptrdiff_t
 #include <assert.h>  // assert()
 #include "blib.h"    // blib defines
+#include "dllpool.h" // dllitem<T> slab allocator
+#include "dllcursor.h" // the last-access cursor
 
 
 using std::string;
@@ -51,6 +81,19 @@ template <class T> class dllitem;
 template <class T> class dllist;
 template <class T> class dllit;
 template <class T> class cdllit;
+template <class T> class dllstlit;
+template <class T> struct dllskip;
+template <class T> struct dllindex;
+template <class T> struct dllext;
+
+
+// comment out the next line if you want each dllitem<T> allocated with its own new
+//  and purge() to delete nodes one by one, rather than using the dllpool<T> slabs
+#define  DLLIST_POOL_NODES  1
+
+// depth of the run stack used by dllist<T>::merge_sort(),
+//  enough for 2^32 runs, so for any uint length
+#define  DLL_SORT_LEVELS  33
 
 
 // Template : class dllitem
@@ -70,15 +113,141 @@ template <class T> class dllitem
         friend class dllist<T>;
         friend class dllit<T>;
         friend class cdllit<T>;
+        friend class dllpool<T>;
+        friend class dllstlit<T>;
+        friend struct dllindex<T>;
 
     protected:
         // constructor
         dllitem(T* a) : value(a), next(0), prior(0) {}
         dllitem(const T& a) : next(0), prior(0)
         { value = new T; *value = a; }
+
+#ifdef DLLIST_POOL_NODES
+        // node storage comes from the slabs of dllpool<T>
+        static void *operator new(size_t) noexcept
+            { return dllpool<T>::pool().get(); }
+        static void operator delete(void *p)
+            { dllpool<T>::pool().put((dllitem<T> *) p); }
+#endif
 }; // template class dllitem
 
 
+// Template : struct dllskip
+// Purpose  : skip index for dllist<T> positional access,
+//            nodes[k] is the node at list position k*step
+// Note     : built on demand by dllist<T>::node_num(), extended by
+//            add(), and dropped whenever list positions move
+//            node_num() is const, so two readers may both find it unbuilt,
+//            the one holding 'building' builds it, the other walks
+template <class T> struct dllskip
+{
+    uint         want;    // step asked for by index_positions(), 0 for about sqrt(length)
+    uint         step;    // list positions between indexed nodes
+    uint         count;   // number of nodes[] entries
+    uint         room;    // number of nodes[] allocated
+    std::atomic<dllitem<T> **> nodes;  // 0 until built, set last, so a reader seeing it sees step and count
+    std::atomic_flag building;         // held by the const reader building the index
+
+    dllskip(uint w) : want(w), step(0), count(0), room(0), nodes(0) { building.clear(); }
+    ~dllskip(void) { delete [] nodes; }
+    void drop(void) { delete [] nodes; nodes = 0; count = 0; room = 0; }
+    void append(dllitem<T> *, uint);  // a node was added at the end, at this position
+}; // template struct dllskip
+
+
+// Template : struct dllindex
+// Purpose  : hash index of a dllist<T>'s nodes, by value pointer,
+//            and by whichever of a string key, an integer key and
+//            a value hash the list was given by index_members()
+// Note     : kept up to date on every node added or removed, a
+//            value's keys must not change while it is in the list
+//            nodes with a 0 value are only indexed by pointer
+template <class T> struct dllindex
+{
+    typedef std::unordered_multimap<const T *, dllitem<T> *>  ptr_map;
+    typedef std::unordered_multimap<string, dllitem<T> *>     str_map;
+    typedef std::unordered_multimap<long, dllitem<T> *>       num_map;
+    typedef std::unordered_multimap<size_t, dllitem<T> *>     hash_map;
+
+    string (*str_key)(const T *);    // string T::matches() compares with, or 0
+    long   (*num_key)(const T *);    // integer T::matches() compares with, or 0
+    size_t (*hash)(const T &);       // hash agreeing with T::operator==(), or 0
+    ptr_map  by_ptr;
+    str_map  by_str;
+    num_map  by_num;
+    hash_map by_hash;
+
+    dllindex(string (*s)(const T *), long (*n)(const T *), size_t (*h)(const T &))
+        : str_key(s), num_key(n), hash(h) {}
+    void insert(dllitem<T> *);   // index a node just linked into the list
+    void erase(dllitem<T> *);    // forget a node about to leave the list
+    void clear(void)             // forget every node
+        { by_ptr.clear(); by_str.clear(); by_num.clear(); by_hash.clear(); }
+
+    // the one node under 'key' passing 'match', 0 if there is none,
+    //  'many' is set if more than one passed, so the list must be searched
+    template <class M, class K, class P>
+    static dllitem<T> *sole(const M &, const K &, P, bool &many);
+    template <class M, class K>
+    static void erase_from(M &, const K &, dllitem<T> *);  // remove one node from under 'key'
+}; // template struct dllindex
+
+
+// Template : struct dllext
+// Purpose  : the parts of a dllist only some lists use, the cursor,
+//            the skip and hash indexes and the count of lists sharing
+//            the nodes, behind one pointer, which stays 0 until one of
+//            them is first needed, so a plain list is just its head,
+//            that pointer and its length
+template <class T> struct dllext
+{
+    dllcursor< dllitem<T> > cursor; // node found by last positional access, and its position
+    dllskip<T>        *skip;        // skip index, 0 unless index_positions() called
+    dllindex<T>       *index;       // hash index, 0 unless index_members() called
+    std::atomic<std::atomic<uint> *> refs;  // lists sharing these nodes, 0 unless shared
+
+    dllext(void) : skip(0), index(0), refs(0) {}
+    ~dllext(void) { delete skip; delete index; }
+}; // template struct dllext
+
+
+// Template : struct dllradix
+// Purpose  : maps a radix_sort() key onto an unsigned integer that
+//            orders the same way, so keys can be sorted byte by byte
+//            unsigned integers are used as they are, signed integers
+//            have their sign bit flipped, and IEEE floats have every
+//            bit flipped if negative, or just the sign bit if not
+template <class K, bool F = std::is_floating_point<K>::value,
+                   bool S = std::is_signed<K>::value> struct dllradix;
+
+template <class K, bool S> struct dllradix<K, true, S>    // float, double
+{
+    static_assert( sizeof(K) == 4 || sizeof(K) == 8, "radix_sort() takes 32 or 64 bit floats" );
+    typedef typename std::conditional<sizeof(K) == 4, unsigned int, unsigned long long>::type U;
+    static unsigned long long bits(K k)
+    {   if( k == 0 ) k = 0;  // -0.0 sorts with 0.0
+        U u;
+        memcpy(&u, &k, sizeof(U));
+        const U sign = U(1) << (sizeof(U) * 8 - 1);
+        return (u & sign) ? U(~u) : U(u | sign); }
+}; // template struct dllradix<K, true, S>
+
+template <class K> struct dllradix<K, false, true>        // signed integers
+{
+    static_assert( sizeof(K) <= 8, "radix_sort() takes keys of up to 64 bits" );
+    static unsigned long long bits(K k)
+    {   typedef typename std::make_unsigned<K>::type U;
+        return (unsigned long long)(U(k) ^ (U(1) << (sizeof(K) * 8 - 1))); }
+}; // template struct dllradix<K, false, true>
+
+template <class K> struct dllradix<K, false, false>       // unsigned integers
+{
+    static_assert( sizeof(K) <= 8, "radix_sort() takes keys of up to 64 bits" );
+    static unsigned long long bits(K k) { return (unsigned long long) k; }
+}; // template struct dllradix<K, false, false>
+
+
 // Template: class dllist
 // Purpose : doublely-linked list container for dllitem elements
 // Warning : when the list is purged, deleted, or has any node removed
@@ -90,11 +259,32 @@ template <class T> class dllitem
 //           in the list, if you actually want to free the space
 //           pointed to by the value pointers, free_all()
 //           (but note: free for value pointers is not an array delete)
+// Note    : lookups by pointer, by T::operator==() and by the string or
+//           integer T::matches() are O(1) once index_members() is called,
+//           they fall back to a search of the list if the key is shared
+//           by more than one node, the index costs nothing until then
+// Note    : positional access (operator[], get_num(), add_num(),
+//           remove_num(), start_at()) walks from whichever is nearest
+//           of the head, the last node, the node found by the last
+//           positional access, or a skip index entry if index_positions()
+//           was called, so stepping through positions in order is O(1)
+//           a const positional access moves that cached position, a
+//           dllcursor, which is kept whole by a sequence count, and may
+//           build the skip index, which is published whole, so several
+//           threads may read one list by position at once, as by iterator
+// Note    : copies made by the copy constructor or operator=() share
+//           the original's nodes, in O(1), until either list is changed,
+//           then the changed list copies the nodes for itself first,
+//           so reading a copy costs what reading the original does
+//           a dllit or cdllit on the changed list finds its position again
+//           among the new nodes, and several threads may copy one list at once
 template <class T> class dllist
 {
     private:
-        dllitem<T> *head;  // pointer to first element
-        uint length;       // length of list
+        dllitem<T> *head;              // pointer to first element
+        mutable std::atomic<dllext<T> *> ext;  // cursor, indexes and sharing, 0 until one is used
+        uint length;                   // length of list
+        uint gen;                      // counts unshare()s, so iterators know the nodes were replaced
 
         friend class dllit<T>;
         friend class cdllit<T>;
@@ -103,15 +293,68 @@ template <class T> class dllist
         bool lessthan_dll(const dllitem<T> *, const dllitem<T> *) const;  // uses T::dll_lessthan() to decide (a < b)
         bool lessthan(const dllitem<T> *, const dllitem<T> *,             // uses the 3rd argument to decide (a < b)
                       bool (*)(const T *, const T *)) const;
-        // exhanges list positions of passed & passed->next
-        void swap(dllitem<T> *);
+        // stable natural merge sort, greatest-to-least, by a node less-than
+        template <class LT> uint merge_sort(LT);
+        template <class LT> static dllitem<T> *merge_chains(dllitem<T> *, dllitem<T> *, LT &, uint &);
+        // the same sort, on up to the given number of threads
+        template <class LT> uint parallel_merge_sort(LT, uint);
+        template <class LT> struct sort_job   // one worker's share of parallel_merge_sort()
+        {
+            dllist<T>   *part;         // sublist to merge_sort(), or 0 to merge a and b
+            dllitem<T>  *a, *b;        // 0 terminated chains to merge, a holds the earlier nodes
+            LT          *lt;
+            uint         comparisons;
+
+            static void *run(void *job)  // blib::Thread entry point
+            {   sort_job<LT> *j = (sort_job<LT> *) job;
+                if( j->part ) j->comparisons += j->part->merge_sort(*j->lt);
+                else j->a = merge_chains(j->a, j->b, *j->lt, j->comparisons);
+                return 0; }
+        }; // struct sort_job
+        template <class LT> static void run_jobs(sort_job<LT> *, uint);
+        void close_chain(dllitem<T> *);    // make a 0 terminated next-chain the whole ring, head first
+        dllext<T> *extension(void) const   // ext, or 0 if none was made yet
+            { return ext.load(std::memory_order_acquire); }
+        dllext<T> *extra(void) const;      // ext, made if there is none yet
+        dllskip<T> *skip(void) const       // skip index, or 0
+            { dllext<T> *x = extension(); return x ? x->skip : 0; }
+        dllindex<T> *index(void) const     // hash index, or 0
+            { dllext<T> *x = extension(); return x ? x->index : 0; }
+        std::atomic<uint> *refs(void) const  // shared node count, or 0
+            { dllext<T> *x = extension(); return x ? x->refs.load() : 0; }
+        // positional access
+        dllitem<T> *node_num(uint) const;  // return i-th node (i < length), updates cursor
+        dllitem<T> **build_skip(void) const;  // build the skip index, its nodes, 0 if another thread is
+        void set_cursor(dllitem<T> *n, uint i) const  // the next positional access may start from n, at i
+            { extra()->cursor.set(n, i); }
+        void changed(void)                 // forget cursor & skip index, list positions have moved
+            { dllext<T> *x = extension(); if( x ) { x->cursor.clear(); if( x->skip ) x->skip->drop(); } }
+        void appended(dllitem<T> *n)       // a node was linked in at the end, before length counts it
+            { dllskip<T> *s = skip(); if( s && s->nodes ) s->append(n, length); }
+        // membership index
+        void indexed(dllitem<T> *n)        // a node was linked in
+            { dllindex<T> *x = index(); if( x ) x->insert(n); }
+        void unindexed(dllitem<T> *n)      // a node is about to be unlinked
+            { dllindex<T> *x = index(); if( x ) x->erase(n); }
+        void drop_node(dllitem<T> *);      // unlink and free a node found through the index
+        template <class G> static uint draw(G &, uint);  // uniform pick from 0..n-1 by a RandGen
+        // copy-on-write
+        static void free_ring(dllitem<T> *, uint);  // free a ring of nodes, not their values
+        bool release(void);                // stop sharing, true if the nodes are *this' to free
+        void unshare(void);                // copy shared nodes so *this has its own
+        void detach(void)                  // call before changing the nodes
+            { if( refs() ) unshare(); }
 
     public:
+        typedef cdllit<T> citerator;   // const iterator type, for templates taking any blib list
+        typedef dllstlit<T> const_iterator;  // standard iterator type, see begin()
+
         // constructors
-        dllist() : head(0), length(0) {}
-        dllist(const dllist<T> &a) : head(0), length(0) { operator=(a); }
+        dllist() : head(0), ext(0), length(0), gen(0) {}
+        dllist(const dllist<T> &a) : head(0), ext(0), length(0), gen(0)
+            { operator=(a); }
         // destructor
-        ~dllist() { purge(); }  // this only frees the list points, does not delete values pointed to
+        ~dllist() { purge(); delete extension(); }  // this only frees the list points, does not delete values pointed to
 
         // mutators
         void operator=(const dllist<T> &);   // assign *this to a copy of arguement's list pointers, that point to the same values as the argument's pointers
@@ -120,6 +363,8 @@ template <class T> class dllist
         void copy(const dllist<T> &);        // purge() *this, copy instances from arg, new T objects values built
         void pUnion(const dllist<T> &);      // make *this = *this U argument, new pointers point to argument's values, no new objects build
         void Union(const dllist<T> &);       // make *this = *this U argument, new pointers point to newly built objects copied with T::operator=()
+        template <class H>
+        void Union(const dllist<T> &, H);    // same as Union(), in O(n+m), H is a hash of const T& agreeing with T::operator==()
         void append_and_purge(dllist<T> &);  // places arguement's actual pointer list onto end of *this, thus leaving arguement in a purge()d state
         void prepend_and_purge(dllist<T> &); // places arguement's actual pointer list onto beginning of *this, thus leaving arguement in a purge()d state
         void add_list(const dllist<T> &a) { *this += a; }
@@ -143,6 +388,29 @@ template <class T> class dllist
         uint sort(void);                     // sorts the list greast-to-least with T::operator<(const T*)
         uint sort_dll(void);                 // sorts the list greast-to-least with T::dll_lessthan(const T*)
         uint sort(bool (*)(const T*, const T*));
+        template <class LT>
+        uint sort(LT);                       // sorts the list greast-to-least with any callable lt(T*, T*), which can be inlined
+        template <class KF>
+        uint sort_by_key(KF);                // sorts the list greast-to-least by key(T*), taken once per node, compared with <
+        template <class KF>
+        uint radix_sort(KF, bool ascending = false);  // sorts the list greast-to-least (or least-to-greatest) by an integer or float key(T*), in O(N)
+        // the parallel sorts are defined in dllpsort.h, include it to call them
+        uint parallel_sort(uint threads = 0);      // sort() on up to 'threads' threads, 0 for one per processor
+        uint parallel_sort(int threads)            // so parallel_sort(0) is not taken for a null function
+            { return parallel_sort(threads > 0 ? (uint) threads : 0u); }
+        uint parallel_sort_dll(uint threads = 0);  // sort_dll() on up to 'threads' threads
+        uint parallel_sort(bool (*)(const T*, const T*), uint threads = 0);
+        void index_positions(uint step = 0)  // keep a skip index of every step-th node (0 for about sqrt(size())), speeds random positional access
+            { dllext<T> *x = extra(); delete x->skip; x->skip = new dllskip<T>(step); }
+        void unindex_positions(void)         // stop keeping the skip index
+            { dllext<T> *x = extension(); if( x ) { delete x->skip; x->skip = 0; } }
+        void index_members(string (*)(const T*) = 0,   // keep a hash index of the nodes by pointer, and by the given
+                           long (*)(const T*) = 0,     //  string key, integer key and value hash, where given
+                           size_t (*)(const T&) = 0);
+        void unindex_members(void)           // stop keeping the hash index
+            { dllext<T> *x = extension(); if( x ) { delete x->index; x->index = 0; } }
+        template <class G>
+        void shuffle(G &);                   // put the nodes in a uniformly random order, in O(N), G is a RandGen
 
         // inspectors
         bool identical(const dllist<T>&) const;    // identity by *value == *value
@@ -156,17 +424,25 @@ template <class T> class dllist
         T* match_in_list(const int) const;                     // report if a match to int key is in list, comparing with T::matches(const int)
         T* match_in_list(const uint) const;                    // report if a match to uint key is in list, comparing with T::matches(const uint)
         T* match_in_list(const double) const;                  // return 1st match to double key in list, comparing with "bool T::matches(const double&) const"
-        T& operator[](uint) const;                 // return reference to ith node
-        T* get_num(const uint) const;              // return pointer to ith node
+        T& operator[](uint) const;                 // return reference to ith node, moves the cursor
+        T* get_num(const uint) const;              // return pointer to ith node, moves the cursor
         T* first(void) const                       // return value of head node
             { if( length ) return head->value; else return 0; }
         T* last(void) const                        // return value of last node
             { if( length ) return head->prior->value; else return 0; }
         T* rand(void) const;                       // return randomly selected node
+        template <class G>
+        T* rand(G &) const;                        // same, picked by a RandGen, O(1) once index_positions(1) is called, moves the cursor
+        template <class G>
+        uint sample(uint, dllist<T> &, G &) const; // add k values picked uniformly without replacement to a list, in one pass
         void seed(void) const;                     // seed the random generator
         bool empty(void) const                     // report if list is empty
             { if( length ) return false; else return true; }
         uint size(void) const { return length; }    // report size of list
+        dllstlit<T> begin(void) const              // standard iterator at the first value, end() if empty, for range-for and <algorithm>
+            { return dllstlit<T>(length ? head : 0, head); }
+        dllstlit<T> end(void) const                // standard iterator past the last value
+            { return dllstlit<T>(0, head); }
 }; // template class dllist
 
 
@@ -174,38 +450,51 @@ template <class T> class dllist
 // Purpose  : iterator class for dllist
 // Note     : to use dllit a dllist must have been declared,
 //            and must have AT LEAST ONE ELEMENT, or ptr will be NULL
+// Note     : when the list copies the nodes it shared with a copy
+//            (see dllist<T>::unshare()), the iterator finds its position
+//            again among the list's own nodes before its next use
 template <class T> class dllit
 {
     private:
-        dllitem<T> *ptr;       // pointer to current iteration
+        mutable dllitem<T> *ptr;  // pointer to current iteration
         dllist<T>  &list;      // list being iterated
         bool       step_made;  // flags whether iteration has begun
-        uint       i;          // maintains iterative position
+        mutable uint i;        // maintains iterative position
+        mutable uint gen;      // list.gen when ptr was found
 
         friend class dllist<T>;
 
+        void sync(void) const      // the list replaced its nodes, find position i among the new ones
+            { if( gen == list.gen ) return; gen = list.gen; if( !ptr ) return;
+              if( i >= list.length ) i = list.length ? list.length - 1 : 0;
+              ptr = list.length ? list.node_num(i) : 0; }
+        void own(void)             // give a shared list its own nodes, keeping position i
+            { list.detach(); sync(); }
+
     public:
         // constructor
-        dllit(dllist<T> &L) : ptr(L.head), list(L), step_made(false), i(0) {}
+        dllit(dllist<T> &L) : ptr(L.head), list(L), step_made(false), i(0), gen(L.gen) {}
         dllit(dllist<T> &L, const uint &s)
-            : ptr(L.head), list(L), step_made(false), i(0)
-            { for(uint  j = 0; j < s; j++) ++(*this); }
+            : ptr(L.head), list(L), step_made(false), i(0), gen(L.gen)
+            { start_at(s); }
 
         // mutators
         void start(void)           // start iteration over again
-            { ptr = list.head; step_made = false; i = 0; }
-        void start_at(const uint& s)
-            { start(); for(uint  j = 0; j < s; j++) ++(*this); } 
+            { ptr = list.head; step_made = false; i = 0; gen = list.gen; }
+        void start_at(const uint& s)  // same as start() then s ++'s, positions past the end wrap around
+            { start(); if( !list.length || !s ) return;
+              i = s % list.length; ptr = list.node_num(i); step_made = true; }
         T *operator++(void)        // increment element being pointed to
-            { if(ptr) ptr = ptr->next; step_made = true;
+            { sync(); if(ptr) ptr = ptr->next; step_made = true;
               if(ptr == list.head) i = 0; else i++;
               if(ptr) return ptr->value; return 0; }
         T *operator--(void)        // decrement element being pointed to
-            { if(ptr) ptr = ptr->prior; step_made = true;
+            { sync(); if(ptr) ptr = ptr->prior; step_made = true;
               if(ptr == list.head->prior) i = list.length - 1; else i--;
               if(ptr) return ptr->value; return 0; }
         T *operator=(T *a)         // assign value of element pointed to
-            { if( ptr ) ptr->value = a;
+            { own();
+              if( ptr ) { list.unindexed(ptr); ptr->value = a; list.indexed(ptr); }
               else { list.add(a); start(); } return a; }
         uint add_before(T *);      // adds node before iterator position
         uint add_after(T *);       // adds node after iterator position
@@ -216,15 +505,15 @@ template <class T> class dllit
 
         // inspectors
         uint num(void) const       // return iteration position
-            { return i; }
+            { sync(); return i; }
         T *operator()(void) const  // inspect value interator is pointing to
-            { if(ptr) return ptr->value; return 0; }
+            { sync(); if(ptr) return ptr->value; return 0; }
         bool at_start(void) const  // is iterator pointing to first element?
-            { if( list.length ) return ptr == list.head; return false; }
+            { sync(); if( list.length ) return ptr == list.head; return false; }
         bool at_end(void) const    // is iterator pointing to last element?
-            { if( list.length ) return ptr == list.head->prior; return true; }
+            { sync(); if( list.length ) return ptr == list.head->prior; return true; }
         bool finished(void) const  // has a full list iteration occured ? 
-            { if( list.length ) 
+            { sync(); if( list.length ) 
               { if( step_made ) return ptr == list.head; else return false; }
               return true; }
         bool done(void) const      // second name for finished()
@@ -259,50 +548,62 @@ template <class T> class dllit
 // Purpose  : const iterator class for dllist
 // Note     : to use cdllit a dllist must have been declared,
 //            and must have AT LEAST ONE ELEMENT, or ptr will be NULL
+// Note     : as dllit, it finds its position again when the list
+//            copies the nodes it shared (see dllist<T>::unshare())
 template <class T> class cdllit
 {
     private:
-        dllitem<T> *ptr;       // pointer to current iteration
-        dllitem<T> *head;      // pointer to head of list
+        mutable dllitem<T> *ptr;   // pointer to current iteration
+        mutable dllitem<T> *head;  // pointer to head of list
         bool       step_made;  // flags whether iteration has begun
-        uint       i;          // maintains iterative position
-        uint       length;     // list length
+        mutable uint i;        // maintains iterative position
+        mutable uint length;   // list length
+        const dllist<T> &list; // list being iterated
+        mutable uint gen;      // list.gen when head was read
 
         friend class dllist<T>;
 
+        void sync(void) const      // the list replaced its nodes, find position i among the new ones
+            { if( gen == list.gen ) return; gen = list.gen;
+              head = list.head; length = list.length; if( !ptr ) return;
+              if( i >= length ) i = length ? length - 1 : 0;
+              ptr = length ? list.node_num(i) : 0; }
+
     public:
         // constructor
         cdllit(const dllist<T> &L)
-            : ptr(L.head), head(L.head), step_made(false), i(0), length(L.length) {}
+            : ptr(L.head), head(L.head), step_made(false), i(0), length(L.length), list(L), gen(L.gen) {}
         cdllit(const dllist<T> &L, const uint &s)
-            : ptr(L.head), head(L.head), step_made(false), i(0), length(L.length)
-            { for(uint  j = 0; j < s; j++) ++(*this); }
+            : ptr(L.head), head(L.head), step_made(false), i(0), length(L.length), list(L), gen(L.gen)
+            { start_at(s); }
 
         // mutators
         void start(void)           // start iteration over again
-            { ptr = head; step_made = false; i = 0; }
-        void start_at(const uint& s)
-            { start(); for(uint  j = 0; j < s; j++) ++(*this); } 
+            { sync(); ptr = head; step_made = false; i = 0; }
+        void start_at(const uint& s)  // same as start() then s ++'s, positions past the end wrap around,
+                                      //  moves the list's cursor, as get_num() does
+            { start(); if( !length || !s ) return;
+              i = s % length; ptr = list.node_num(i); step_made = true; }
         T *operator++(void)        // increment element being pointed to
-            { if(ptr) ptr = ptr->next; step_made = true;
+            { sync(); if(ptr) ptr = ptr->next; step_made = true;
               if(ptr == head) i = 0; else i++;
               if(ptr) return ptr->value; return 0; }
         T *operator--(void)        // decrement element being pointed to
-            { if(ptr) ptr = ptr->prior; step_made = true;
+            { sync(); if(ptr) ptr = ptr->prior; step_made = true;
               if(ptr == head->prior) i = length - 1; else i--;
               if(ptr) return ptr->value; return 0; }
 
         // inspectors
         uint num(void) const       // return iteration position
-            { return i; }
+            { sync(); return i; }
         T *operator()(void) const  // inspect value interator is pointing to
-            { if(ptr) return ptr->value; return 0; }
+            { sync(); if(ptr) return ptr->value; return 0; }
         bool at_start(void) const  // is iterator pointing to first element?
-            { if( length ) return ptr == head; return false; }
+            { sync(); if( length ) return ptr == head; return false; }
         bool at_end(void) const    // is iterator pointing to last element?
-            { if( length ) return ptr == head->prior; return true; }
+            { sync(); if( length ) return ptr == head->prior; return true; }
         bool finished(void) const  // has a full list iteration occured ? 
-            { if( length ) 
+            { sync(); if( length ) 
               { if( step_made ) return ptr == head; else return false; }
               return true; }
         bool done(void) const      // second name for finished()
@@ -333,6 +634,53 @@ template <class T> class cdllit
 }; // template class cdllit
 
 
+// Template : class dllstlit
+// Purpose  : standard bidirectional iterator over the value pointers of
+//            a dllist, from begin() to end(), so a dllist can be used in
+//            a range-for, for(T *v : list), and with the std algorithms,
+//            for random access (and the parallel algorithms) see dllarray
+// Note     : the values are read as T *const &, the pointers can't be
+//            reassigned through it, the T's they point to can be
+//            past the last node the iterator holds a 0 node, and
+//            -- from there steps back to the last node
+//            changing the list invalidates the iterator, even the first
+//            change of a shared list, which gives the list new nodes,
+//            unlike dllit and cdllit it does not find its place again
+template <class T> class dllstlit
+{
+    private:
+        const dllitem<T> *ptr;    // node of current iteration, 0 past the end
+        const dllitem<T> *head;   // head of list
+
+    public:
+        typedef std::bidirectional_iterator_tag  iterator_category;
+        typedef T*                               value_type;
+        typedef std::ptrdiff_t                   difference_type;
+        typedef T* const*                        pointer;
+        typedef T* const&                        reference;
+
+        // constructor
+        dllstlit(void) : ptr(0), head(0) {}
+        dllstlit(const dllitem<T> *p, const dllitem<T> *h) : ptr(p), head(h) {}
+
+        // mutators
+        dllstlit<T> &operator++(void)      // on to the next node, or past the end after the last
+            { ptr = ptr->next == head ? 0 : ptr->next; return *this; }
+        dllstlit<T> operator++(int)
+            { dllstlit<T> was = *this; ++*this; return was; }
+        dllstlit<T> &operator--(void)      // back to the prior node, or the last from past the end
+            { ptr = ptr ? ptr->prior : head->prior; return *this; }
+        dllstlit<T> operator--(int)
+            { dllstlit<T> was = *this; --*this; return was; }
+
+        // inspectors
+        reference operator*(void) const   { return ptr->value; }
+        pointer operator->(void) const    { return &ptr->value; }
+        bool operator==(const dllstlit<T> &a) const { return ptr == a.ptr; }
+        bool operator!=(const dllstlit<T> &a) const { return ptr != a.ptr; }
+}; // template class dllstlit
+
+
 } // namespace blib
 
 #include "dll.cxx"   // included b/c dll is a set of template classes, not compilable itself
@@ -0,0 +1,77 @@
+/*****************************************************************************/
+/*** Software: AMOS v0.01 (c)1998 All Rights Reserved by Bradley B. Custer ***/
+/*****************************************************************************/
+
+// File    : dllcursor.h
+// Purpose : contains template for the remembered position of a list,
+//           the node (or chunk) found by its last positional access and
+//           that node's position, which const readers move, so it is
+//           kept whole between threads by a sequence count
+//
+// Update Log -
+//
+// 20261017 - Begun
+
+
+// prototypes
+namespace blib
+{
+template <class N> struct dllcursor;
+} // namespace blib
+
+
+#ifndef DLLIST_CURSOR_TEMPLATE
+#define DLLIST_CURSOR_TEMPLATE
+
+
+#include <atomic>    // for the node, position and sequence count
+#include "blib.h"    // blib defines
+
+
+namespace blib
+{
+
+
+// Template : struct dllcursor
+// Purpose  : a {node, position} pair, a hint where the next positional
+//            access of a list may start walking, for dllist<T> and
+//            udllist<T>, whose const readers move it
+// Note     : seq is odd while a thread moves the pair, a reader takes the
+//            pair only if seq was even and unchanged across its read, and
+//            a thread finding seq odd leaves the pair be, so concurrent
+//            readers of one list never see a node with another's position,
+//            and never wait on each other, at worst they walk further
+//            the list's mutators hold the list alone, as always, so their
+//            set() and clear() always take
+template <class N> struct dllcursor
+{
+    std::atomic<N *>  node;  // 0 if unknown
+    std::atomic<uint> num;   // list position of node
+    std::atomic<uint> seq;   // odd while being moved
+
+    dllcursor(void) : node(0), num(0), seq(0) {}
+
+    bool get(N *&n, uint &i) const  // the pair, false if unknown or being moved
+        { uint s = seq.load(std::memory_order_acquire);
+          if( s & 1 ) return false;
+          n = node.load(std::memory_order_acquire);  // acquire, so the seq load below stays after them
+          i = num.load(std::memory_order_acquire);
+          return n && seq.load(std::memory_order_relaxed) == s; }
+    void set(N *n, uint i)          // move the pair, unless another thread is
+        { uint s = seq.load(std::memory_order_relaxed);
+          if( (s & 1) || !seq.compare_exchange_strong(s, s + 1, std::memory_order_acquire) ) return;
+          node.store(n, std::memory_order_release);  // release, so a reader of either sees seq odd
+          num.store(i, std::memory_order_release);
+          seq.store(s + 2, std::memory_order_release); }
+    void clear(void)                // forget the pair, list positions have moved
+        { set(0, 0); }
+    N *at(void) const               // the node, for the mutators to compare
+        { return node.load(std::memory_order_relaxed); }
+}; // template struct dllcursor
+
+
+} // namespace blib
+
+#endif // DLLIST_CURSOR_TEMPLATE
+
+// dllcursor.h
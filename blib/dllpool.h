@@ -0,0 +1,196 @@
+/*****************************************************************************/
+/*** Software: AMOS v0.01 (c)1998 All Rights Reserved by Bradley B. Custer ***/
+/*****************************************************************************/
+
+// File    : dllpool.h
+// Purpose : contains template for a slab allocator of dllitem<T> nodes
+//           dllpool hands out list nodes carved from contiguous blocks,
+//           so building and purge()ing big lists stays out of malloc/free
+//
+// Update Log -
+//
+// 20261017 - Begun
+
+
+// prototypes
+namespace blib
+{
+template <class T> class dllitem;
+template <class T> class dllpool;
+} // namespace blib
+
+
+#ifndef DLLITEM_POOL_TEMPLATE
+#define DLLITEM_POOL_TEMPLATE
+
+
+#include <new>       // for std::nothrow
+#include <atomic>    // for std::atomic_flag
+#include "blib.h"    // blib defines
+
+
+namespace blib
+{
+
+
+// size of the first slab a dllpool<T> allocates, each following slab
+//  doubles in size up to DLLPOOL_MAX_SLAB nodes
+#define  DLLPOOL_FIRST_SLAB  64
+#define  DLLPOOL_MAX_SLAB    65536
+
+
+// Template : class dllpool
+// Purpose  : slab allocator for dllitem<T> nodes, there is one
+//            dllpool per type T, shared by every dllist<T>
+//            nodes are cut from slabs of contiguous memory, and freed
+//            nodes are kept on a free list chained through dllitem::next,
+//            so a whole list's ring of nodes can be given back in O(1)
+// Note     : the pool for each T is allocated on first use and is never
+//            destructed, so a static dllist<T> (like RandGenCMWC::lag_list)
+//            can still purge() itself during program exit; slabs are given
+//            back to the system by release(), once no node is checked out
+//            the free list is guarded by a spin lock, so lists of the same
+//            T may be built and purge()d from different threads
+template <class T> class dllpool
+{
+    private:
+        struct slab          // header of each allocated block,
+        {   slab *next;      //  the block's nodes follow it
+            ulong nodes;
+        }; // struct slab
+
+        dllitem<T>       *free_list;  // chained through dllitem<T>::next
+        slab             *slabs;      // every block allocated
+        ulong             slab_size;  // nodes in the next slab allocated
+        ulong             in_use;     // nodes checked out of the pool
+        ulong             reserved;   // nodes in all slabs
+        std::atomic_flag  guard;      // spin lock for all of the above
+
+        void lock(void)   { while( guard.test_and_set(std::memory_order_acquire) ) ; }
+        void unlock(void) { guard.clear(std::memory_order_release); }
+        bool grow(void);  // allocate another slab onto the free list
+
+        dllpool(void) : free_list(0), slabs(0), slab_size(DLLPOOL_FIRST_SLAB),
+                        in_use(0), reserved(0)
+            { guard.clear(); }
+        dllpool(const dllpool<T> &);          // not copyable
+        void operator=(const dllpool<T> &);
+
+    public:
+        // the one pool used for type T
+        static dllpool<T> &pool(void)
+            { static dllpool<T> *p = new dllpool<T>; return *p; }
+
+        // mutators
+        void *get(void);                                // check out one node, 0 if allocation failed
+        void put(dllitem<T> *);                         // give one node back
+        void put_ring(dllitem<T> *, ulong);             // give back a whole circular list of nodes, in O(1)
+        bool release(void);                             // free every slab, only done if no node is checked out
+
+        // inspectors
+        ulong nodes_in_use(void) const { return in_use; }
+        ulong nodes_reserved(void) const { return reserved; }
+}; // template class dllpool
+
+
+// Template : bool dllpool<T>::grow(void)
+// Purpose  : allocate a new slab and thread its nodes onto the free list
+//            the lock must already be held by the caller
+// Returns  : false if the allocation failed
+template <class T> bool dllpool<T>::grow(void)
+{
+    slab *s = (slab *) ::operator new(sizeof(slab) + slab_size * sizeof(dllitem<T>),
+                                      std::nothrow);
+    if( !s ) return false;  // memory allocation failed
+
+    s->next  = slabs;
+    s->nodes = slab_size;
+    slabs    = s;
+
+    // the slab's nodes start just past its header, link them
+    //  back-to-front so they are handed out in address order
+    dllitem<T> *node = (dllitem<T> *)(s + 1);
+    for(ulong i = slab_size; i--; )
+    {
+        node[i].next = free_list;
+        free_list    = &node[i];
+    } // for
+
+    reserved += slab_size;
+    if( slab_size < DLLPOOL_MAX_SLAB ) slab_size *= 2;
+    return true;
+} // template dllpool<T>::grow()
+
+
+// Template : void *dllpool<T>::get(void)
+// Purpose  : take a node off the free list, growing the pool if needed
+// Returns  : raw storage for one dllitem<T>
+//            0 if memory allocation failed
+template <class T> void *dllpool<T>::get(void)
+{
+    lock();
+    if( !free_list && !grow() ) { unlock(); return 0; }
+    dllitem<T> *node = free_list;
+    free_list = node->next;
+    in_use++;
+    unlock();
+    return node;
+} // template dllpool<T>::get()
+
+
+// Template : void dllpool<T>::put(dllitem<T> *)
+// Purpose  : push one node back onto the free list
+template <class T> void dllpool<T>::put(dllitem<T> *node)
+{
+    if( !node ) return;
+    lock();
+    node->next = free_list;
+    free_list  = node;
+    in_use--;
+    unlock();
+} // template dllpool<T>::put()
+
+
+// Template : void dllpool<T>::put_ring(dllitem<T> *, ulong)
+// Purpose  : give back every node of a dllist's circular ring at once,
+//            the ring is cut after its last node and the free list
+//            is hung from there, so no node is visited
+// Note     : 'count' must be the number of nodes in the ring
+template <class T> void dllpool<T>::put_ring(dllitem<T> *head, ulong count)
+{
+    if( !head || !count ) return;
+    lock();
+    head->prior->next = free_list;  // the last node now leads into the free list
+    free_list         = head;
+    in_use           -= count;
+    unlock();
+} // template dllpool<T>::put_ring()
+
+
+// Template : bool dllpool<T>::release(void)
+// Purpose  : give every slab back to the system
+// Returns  : true  - slabs were freed
+//            false - some node is still in a list, nothing done
+template <class T> bool dllpool<T>::release(void)
+{
+    lock();
+    if( in_use ) { unlock(); return false; }
+    while( slabs )
+    {
+        slab *next = slabs->next;
+        ::operator delete(slabs);
+        slabs = next;
+    } // while
+    free_list = 0;
+    reserved  = 0;
+    slab_size = DLLPOOL_FIRST_SLAB;
+    unlock();
+    return true;
+} // template dllpool<T>::release()
+
+
+} // namespace blib
+
+#endif // DLLITEM_POOL_TEMPLATE
+
+// dllpool.h
@@ -0,0 +1,192 @@
+/*****************************************************************************/
+/*** Software: AMOS v0.01 (c)1998 All Rights Reserved by Bradley B. Custer ***/
+/*****************************************************************************/
+
+// File    : dllpsort.h
+// Purpose : contains the dllist<T>::parallel_sort() templates, which
+//           sort a list on blib::Threads
+//           they are kept out of dll.h so that only code which sorts
+//           on threads takes in thread.h and its POSIX defines, include
+//           this header wherever parallel_sort() or parallel_sort_dll()
+//           is called, a call without it fails to link
+//
+// Update Log -
+//
+// 20261017 - Begun, moved parallel_sort(), parallel_sort_dll(), parallel_sort(bool (*)()),
+//            parallel_merge_sort() and run_jobs() here from dll.cxx
+
+
+#ifndef DLLIST_PARALLEL_SORT_TEMPLATE
+#define DLLIST_PARALLEL_SORT_TEMPLATE
+
+
+#include <unistd.h>  // for sysconf()
+#include <pthread.h> // before thread.h, so it is declared outside namespace blib
+#include "thread.h"  // for parallel_merge_sort()'s workers
+#include "dll.h"
+
+
+namespace blib
+{
+
+
+// parallel_sort() sorts lists shorter than DLL_PARALLEL_SORT_THRESHOLD with
+//  sort(), and gives each worker thread at least half that many nodes,
+//  using no more than DLL_PARALLEL_SORT_MAX_THREADS threads
+#define  DLL_PARALLEL_SORT_THRESHOLD    65536
+#define  DLL_PARALLEL_SORT_MAX_THREADS  64
+
+
+// Template : uint dllist<T>::parallel_sort(uint threads)
+// Purpose  : sorts the list greatest-to-least comparing nodes
+//            with T::operator<(), just as sort(), but splitting
+//            the work over up to 'threads' threads (0 for one
+//            per online processor)
+// Returns  : number of comparisons performed for sort, summed
+//            over all the threads
+// Note     : T::operator<() is called from several threads at
+//            once, so it must not change anything shared
+//            see parallel_merge_sort()
+template <class T> uint dllist<T>::parallel_sort(uint threads)
+{
+    return parallel_merge_sort( [this](const dllitem<T> *a, const dllitem<T> *b)
+                                { return lessthan_opr(a, b); }, threads );
+} // template dllist<T>::parallel_sort()
+
+
+// Template : uint dllist<T>::parallel_sort_dll(uint threads)
+// Purpose  : sorts the list greatest-to-least comparing nodes
+//            with T::dll_lessthan(), just as sort_dll(), on up
+//            to 'threads' threads (0 for one per processor)
+// Returns  : number of comparisons performed for sort
+// Note     : see parallel_sort()
+template <class T> uint dllist<T>::parallel_sort_dll(uint threads)
+{
+    return parallel_merge_sort( [this](const dllitem<T> *a, const dllitem<T> *b)
+                                { return lessthan_dll(a, b); }, threads );
+} // template dllist<T>::parallel_sort_dll()
+
+
+// Template : uint dllist<T>::parallel_sort(bool (*)(), uint threads)
+// Purpose  : sorts the list greatest-to-least comparing nodes
+//            with the function 'lt', just as sort(lt), on up
+//            to 'threads' threads (0 for one per processor)
+// Returns  : number of comparisons performed for sort
+// Note     : see parallel_sort()
+template <class T>
+uint dllist<T>::parallel_sort(bool (*lt)(const T *, const T *), uint threads)
+{
+    return parallel_merge_sort( [this, lt](const dllitem<T> *a, const dllitem<T> *b)
+                                { return lessthan(a, b, lt); }, threads );
+} // template dllist<T>::parallel_sort(bool (*))
+
+
+// Template : uint dllist<T>::parallel_merge_sort(LT lt, uint threads)
+// Purpose  : the stable merge sort of merge_sort(), run on threads,
+//            the list is cut into one run of consecutive nodes per
+//            thread, each run is merge_sort()ed as a sublist on its
+//            own thread, then neighboring runs are merged in pairs,
+//            each pair on its own thread, until one run is left
+//            nodes are only relinked, no node or value is allocated
+// Returns  : number of comparisons performed for sort
+// Note     : lists shorter than DLL_PARALLEL_SORT_THRESHOLD, or too
+//            short to give two threads DLL_PARALLEL_SORT_THRESHOLD/2
+//            nodes each, are just merge_sort()ed
+//            a run whose thread can't be started is done by the
+//            calling thread, so the sort always completes
+template <class T> template <class LT>
+uint dllist<T>::parallel_merge_sort(LT lt, uint threads)
+{
+    detach();
+    if( !threads )
+    {   long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (uint) cpus : 1;
+    } // if
+    if( threads > DLL_PARALLEL_SORT_MAX_THREADS ) threads = DLL_PARALLEL_SORT_MAX_THREADS;
+    if( threads > length / (DLL_PARALLEL_SORT_THRESHOLD / 2) )
+        threads = length / (DLL_PARALLEL_SORT_THRESHOLD / 2);
+    if( length < DLL_PARALLEL_SORT_THRESHOLD || threads < 2 )
+        return merge_sort(lt);
+
+    // cut the ring into one sublist per thread
+    dllist<T>    parts[DLL_PARALLEL_SORT_MAX_THREADS];
+    sort_job<LT> jobs[DLL_PARALLEL_SORT_MAX_THREADS];
+    dllitem<T>  *tmp = head;
+    for(uint k = 0; k < threads; k++)
+    {
+        uint size = length / threads + (k < length % threads ? 1 : 0);
+        dllitem<T> *first = tmp, *last = tmp;
+        for(uint j = 1; j < size; j++) last = last->next;
+        tmp = last->next;
+        first->prior     = last;  // close it into a ring of its own
+        last->next       = first;
+        parts[k].head    = first;
+        parts[k].length  = size;
+        jobs[k].part        = &parts[k];
+        jobs[k].a           = jobs[k].b = 0;
+        jobs[k].lt          = &lt;
+        jobs[k].comparisons = 0;
+    } // for
+    run_jobs(jobs, threads);
+
+    uint comparisons = 0;
+    dllitem<T> *runs[DLL_PARALLEL_SORT_MAX_THREADS];
+    for(uint k = 0; k < threads; k++)
+    {   comparisons += jobs[k].comparisons;
+        runs[k] = parts[k].head;
+        runs[k]->prior->next = 0;  // open the sorted ring into a chain
+        parts[k].head   = 0;       // the nodes are *this' again
+        parts[k].length = 0;
+    } // for
+
+    // merge neighboring runs in pairs, the earlier run first, until one is left
+    for(uint count = threads; count > 1; count = (count + 1) / 2)
+    {
+        uint pairs = count / 2;
+        for(uint k = 0; k < pairs; k++)
+        {   jobs[k].part        = 0;
+            jobs[k].a           = runs[2 * k];
+            jobs[k].b           = runs[2 * k + 1];
+            jobs[k].comparisons = 0;
+        } // for
+        run_jobs(jobs, pairs);
+        for(uint k = 0; k < pairs; k++)
+        {   comparisons += jobs[k].comparisons;
+            runs[k] = jobs[k].a;
+        } // for
+        if( count % 2 ) runs[pairs] = runs[count - 1];
+    } // for
+
+    close_chain(runs[0]);
+    return comparisons;
+} // template dllist<T>::parallel_merge_sort()
+
+
+// Template : void dllist<T>::run_jobs(sort_job<LT> *jobs, uint count)
+// Purpose  : run jobs[1..count-1] each on a blib::Thread, and jobs[0]
+//            on the calling thread, returning once all are done
+//            a job whose thread fails to start is run here instead
+template <class T> template <class LT>
+void dllist<T>::run_jobs(sort_job<LT> *jobs, uint count)
+{
+    Thread *workers[DLL_PARALLEL_SORT_MAX_THREADS];
+    for(uint k = 1; k < count; k++)
+    {
+        workers[k] = new Thread(&sort_job<LT>::run, &jobs[k]);
+        if( workers[k]->error_code() )
+        {   delete workers[k];
+            workers[k] = 0;
+        } // if
+    } // for
+
+    sort_job<LT>::run(&jobs[0]);
+    for(uint k = 1; k < count; k++)
+        if( workers[k] ) delete workers[k];  // joins the thread
+        else sort_job<LT>::run(&jobs[k]);
+} // template dllist<T>::run_jobs()
+
+} // namespace blib
+
+#endif // DLLIST_PARALLEL_SORT_TEMPLATE
+
+// dllpsort.h
@@ -0,0 +1,293 @@
+/*****************************************************************************/
+/*** Software: AMOS v0.01 (c)1998 All Rights Reserved by Bradley B. Custer ***/
+/*****************************************************************************/
+
+// File    : dllview.h
+// Purpose : contains templates for lazy views over the blib lists
+//           a view is a cursor with the iterator protocol of cdllit,
+//           filter, transform, take, skip, zip and chunk each wrap
+//           another view, so a chain of them walks the list once,
+//           a value at a time, and builds no list along the way
+//
+// Update Log -
+//
+// 20261017 - Begun
+// 20261017 - added dllarray, a random-access array of a list's value pointers
+
+
+// prototypes
+namespace blib
+{
+template <class D> class dllview;
+template <class I> class dllsource;
+template <class V, class P> class filterview;
+template <class V, class F> class transformview;
+template <class V> class takeview;
+template <class V> class skipview;
+template <class A, class B> class zipview;
+template <class V> class chunkview;
+template <class T> class dllarray;
+} // namespace blib
+
+
+#ifndef DLLIST_VIEW_TEMPLATE
+#define DLLIST_VIEW_TEMPLATE
+
+
+#include <utility>   // for std::pair, std::declval()
+#include <vector>    // for dllarray
+#include "blib.h"    // blib defines
+
+
+namespace blib
+{
+
+
+// Template : class dllview
+// Purpose  : the methods every view has, D is the view class itself
+// Useage   : views are made from a list with view(), and chained,
+//              view(list).filter(p).transform(f).take(10)
+//            each call returns a new view wrapping a copy of the
+//            last, a view is then walked just as a cdllit is,
+//              for(auto v = view(list).filter(p); !v.finished(); ++v)
+//                  .. v() ..
+//            or handed each value with for_each()
+// Note     : a view holds a list iterator, not the values, so it
+//            reads the list as it is when walked, and like any
+//            iterator must not outlive the list or see it changed
+//            copying a view copies its place in the list
+template <class D> class dllview
+{
+    private:
+        const D &self(void) const { return static_cast<const D &>(*this); }
+
+    public:
+        // views of this view
+        template <class P>
+        filterview<D, P> filter(P p) const       // just the values for which p(value) is true
+            { return filterview<D, P>(self(), p); }
+        template <class F>
+        transformview<D, F> transform(F f) const // f(value) in place of each value
+            { return transformview<D, F>(self(), f); }
+        takeview<D> take(uint n) const           // the first n values
+            { return takeview<D>(self(), n); }
+        skipview<D> skip(uint n) const           // all but the first n values
+            { return skipview<D>(self(), n); }
+        template <class B>
+        zipview<D, B> zip(const B &b) const      // std::pair of this and view b's values, until either ends
+            { return zipview<D, B>(self(), b); }
+        chunkview<D> chunk(uint n) const         // take(n) views of each n values in turn
+            { return chunkview<D>(self(), n); }
+
+        // walks of this view, each from a copy of its place
+        template <class F>
+        void for_each(F f) const                 // call f(value) on each value
+            { for(D v = self(); !v.finished(); ++v) f(v()); }
+        uint count(void) const                   // number of values
+            { uint n = 0; for(D v = self(); !v.finished(); ++v) n++; return n; }
+        template <class L>
+        uint add_to(L &list) const               // list.add(value) each value, which must be a T *
+            { uint n = 0; for(D v = self(); !v.finished(); ++v) n += list.add(v()) != 0; return n; }
+}; // template class dllview
+
+
+// Template : class dllsource
+// Purpose  : view of a list, through one of its const iterators
+template <class I> class dllsource : public dllview< dllsource<I> >
+{
+    private:
+        I it;
+
+    public:
+        typedef decltype(std::declval<const I &>()()) value_type;
+
+        explicit dllsource(const I &i) : it(i) {}
+
+        value_type operator()(void) const { return it(); }
+        void operator++(void) { ++it; }
+        bool finished(void) const { return it.finished(); }
+}; // template class dllsource
+
+
+// Template : dllsource<L::citerator> view(const L &)
+// Purpose  : view of every value of a dllist, udllist, adllist,
+//            or any list with a citerator type, from its first
+template <class L>
+inline dllsource<typename L::citerator> view(const L &list)
+{
+    return dllsource<typename L::citerator>(typename L::citerator(list));
+} // template view()
+
+
+// Template : class filterview
+// Purpose  : view of the values of V for which P(value) is true
+// Note     : the view is kept on an accepted value, so P is called
+//            once per value of V as the view is walked
+template <class V, class P> class filterview : public dllview< filterview<V, P> >
+{
+    private:
+        V src;
+        P pred;
+
+        void accept(void)  // move src on to the next value pred accepts
+            { while( !src.finished() && !pred(src()) ) ++src; }
+
+    public:
+        typedef typename V::value_type value_type;
+
+        filterview(const V &v, P p) : src(v), pred(p) { accept(); }
+
+        value_type operator()(void) const { return src(); }
+        void operator++(void) { ++src; accept(); }
+        bool finished(void) const { return src.finished(); }
+}; // template class filterview
+
+
+// Template : class transformview
+// Purpose  : view of F(value) for each value of V
+// Note     : F is called each time operator()() is
+template <class V, class F> class transformview : public dllview< transformview<V, F> >
+{
+    private:
+        V src;
+        F fn;
+
+    public:
+        typedef decltype(std::declval<const F &>()(std::declval<typename V::value_type>())) value_type;
+
+        transformview(const V &v, F f) : src(v), fn(f) {}
+
+        value_type operator()(void) const { return fn(src()); }
+        void operator++(void) { ++src; }
+        bool finished(void) const { return src.finished(); }
+}; // template class transformview
+
+
+// Template : class takeview
+// Purpose  : view of the first n values of V
+template <class V> class takeview : public dllview< takeview<V> >
+{
+    private:
+        V    src;
+        uint left;   // values still to be had
+
+    public:
+        typedef typename V::value_type value_type;
+
+        takeview(const V &v, uint n) : src(v), left(n) {}
+
+        value_type operator()(void) const { return src(); }
+        void operator++(void) { ++src; if( left ) left--; }
+        bool finished(void) const { return !left || src.finished(); }
+}; // template class takeview
+
+
+// Template : class skipview
+// Purpose  : view of the values of V after the first n
+template <class V> class skipview : public dllview< skipview<V> >
+{
+    private:
+        V src;
+
+    public:
+        typedef typename V::value_type value_type;
+
+        skipview(const V &v, uint n) : src(v)
+            { while( n-- && !src.finished() ) ++src; }
+
+        value_type operator()(void) const { return src(); }
+        void operator++(void) { ++src; }
+        bool finished(void) const { return src.finished(); }
+}; // template class skipview
+
+
+// Template : class zipview
+// Purpose  : view of std::pair(value of A, value of B), walking
+//            A and B side by side until either is finished
+template <class A, class B> class zipview : public dllview< zipview<A, B> >
+{
+    private:
+        A a;
+        B b;
+
+    public:
+        typedef std::pair<typename A::value_type, typename B::value_type> value_type;
+
+        zipview(const A &x, const B &y) : a(x), b(y) {}
+
+        value_type operator()(void) const { return value_type(a(), b()); }
+        void operator++(void) { ++a; ++b; }
+        bool finished(void) const { return a.finished() || b.finished(); }
+}; // template class zipview
+
+
+// Template : class chunkview
+// Purpose  : view of V n values at a time, each value of the
+//            chunk view is a takeview of the next n values of V,
+//            the last of them may have fewer
+// Note     : a chunk is a copy of V's place, so walking a chunk
+//            walks V's values a second time, nothing is gathered
+template <class V> class chunkview : public dllview< chunkview<V> >
+{
+    private:
+        V    src;
+        uint n;     // values per chunk
+
+    public:
+        typedef takeview<V> value_type;
+
+        chunkview(const V &v, uint size) : src(v), n(size ? size : 1) {}
+
+        value_type operator()(void) const { return value_type(src, n); }
+        void operator++(void) { for(uint k = n; k-- && !src.finished();) ++src; }
+        bool finished(void) const { return src.finished(); }
+}; // template class chunkview
+
+
+// Template : class dllarray
+// Purpose  : the value pointers of a list gathered, in list order,
+//            into one array, whose begin() and end() are random access
+//            iterators, so the std algorithms which need them, and the
+//            parallel and vectorized ones, can be run over a list's values
+// Useage   : dllarray<T> a(list);
+//            std::reduce(std::execution::par, a.begin(), a.end(), ..)
+// Note     : the array is built by the constructor or build(), in one
+//            walk of the list, later changes to the list aren't seen
+//            until build() is called again, reordering the array (as
+//            std::sort() does) reorders only the array, not the list
+template <class T> class dllarray
+{
+    private:
+        std::vector<T *> values;
+
+    public:
+        typedef T **         iterator;
+        typedef T *const *   const_iterator;
+
+        // constructors
+        dllarray(void) {}
+        template <class L>
+        explicit dllarray(const L &list) { build(list); }
+
+        // mutators
+        template <class L>
+        void build(const L &list)                  // (re)gather the values of a dllist, udllist, adllist, ..
+            { values.clear(); values.reserve(list.size());
+              for(typename L::citerator i(list); !i.finished(); ++i) values.push_back(i()); }
+        iterator begin(void)        { return values.data(); }
+        iterator end(void)          { return values.data() + values.size(); }
+
+        // inspectors
+        const_iterator begin(void) const { return values.data(); }
+        const_iterator end(void) const   { return values.data() + values.size(); }
+        T *operator[](uint i) const      { return values[i]; }
+        uint size(void) const            { return values.size(); }
+        bool empty(void) const           { return values.empty(); }
+}; // template class dllarray
+
+
+} // namespace blib
+
+#endif // DLLIST_VIEW_TEMPLATE
+
+// dllview.h
@@ -10,21 +10,188 @@
 // 19980706 - ported over from mud++ code
 // 19990628 - added HashTable::search_for_calling()
 // 19991116 - refined the remove..() functions
+// 20261017 - added rehash(), next_prime(), place() and shrink(), add_to_table() grows the table
+// 20261017 - added resize(), migrate() and old_bucket() for incremental rehashing, lookup() and the
+//            remove..()s share find_in() and unlink(), chashit::next() also walks the old buckets
+// 20261017 - the ispell hash is the hashispell policy, added the hashwy and hashwyfold policies
+// 20261017 - a key is hashed once a lookup() or remove(), find_in() and unlink() pass nodes of other
+//            hashes, place() and migrate() take the node's hash
+// 20261017 - keys are compared by the hash policy's equal(), not by HASH_INDEX_CASE_SENSITIVE, added
+//            the hashcase policy
+// 20261017 - lookup() no longer calls migrate(), only the mutators move old buckets, place() and
+//            migrate() aren't const
+
+
+#include <cstring>    // for memcpy(), strlen()
+#include <cctype>     // for toupper()
 
 
 namespace blib
 {
 
 
+// 64 bit words for the hash policies, a ulong may be 32 bits
+typedef unsigned long long hash64;
+
+
+// Function : void hash_mul(hash64 &a, hash64 &b)
+// Purpose  : multiply a by b to 128 bits, a gets the low half, b the high
+inline void hash_mul(hash64 &a, hash64 &b)
+{
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 r = (unsigned __int128) a * b;
+    a = (hash64) r;
+    b = (hash64) (r >> 64);
+#else
+    hash64 ha = a >> 32, la = (uint) a, hb = b >> 32, lb = (uint) b;
+    hash64 hh = ha * hb, hl = ha * lb, lh = la * hb, ll = la * lb;
+    hash64 t = ll + (hl << 32), lo = t + (lh << 32);
+    b = hh + (hl >> 32) + (lh >> 32) + (t < ll) + (lo < t);
+    a = lo;
+#endif
+} // hash_mul()
+
+
+// Function : hash64 hash_mum(hash64 a, hash64 b)
+// Purpose  : the two halves of a * b xored, the mixing step of hashwy
+inline hash64 hash_mum(hash64 a, hash64 b)
+{
+    hash_mul(a, b);
+    return a ^ b;
+} // hash_mum()
+
+
+// Function : hash64 hash_fold(hash64 w)
+// Purpose  : fold the a-z bytes of w to A-Z, 8 at a time without a branch,
+//            a byte's high bit is set, by adding, where it is at least
+//            'a', and where it is more than 'z', the bytes between have
+//            0x20 cleared, bytes over 0x7f are left as they are
+inline hash64 hash_fold(hash64 w)
+{
+    const hash64 ones = 0x0101010101010101ULL, high = ones * 0x80;
+    hash64 c = w & ~high;                     // no carry out of a byte
+    hash64 a = c + ones * (0x80 - 'a');
+    hash64 z = c + ones * (0x80 - 'z' - 1);
+    return w ^ ((a & ~z & ~w & high) >> 2);
+} // hash_fold()
+
+
+// Function : hash64 hash_read(const char *p, int n, bool fold)
+// Purpose  : the n (8 or 4) bytes at p as a word, folded if fold
+inline hash64 hash_read(const char *p, int n, bool fold)
+{
+    hash64 w = 0;
+    if( n == 8 ) memcpy(&w, p, 8);
+    else { uint v; memcpy(&v, p, 4); w = v; }
+    return fold ? hash_fold(w) : w;
+} // hash_read()
+
+
+// Template : hash64 hash_wy<FOLD>(const char *s)
+// Purpose  : the hash of hashwy and hashwyfold, wyhash's, for a key of
+//            strlen(s) characters, a-z folded if FOLD
+// Note     : 16 characters or less are read as two words, which may
+//            overlap, longer keys a word pair a multiply at a time, and
+//            over 48, three pairs with their own seeds, before those
+template< bool FOLD > inline hash64 hash_wy(const char *s)
+{
+    static const hash64 k0 = 0xa0761d6478bd642fULL, k1 = 0xe7037ed1a0b428dbULL,
+                        k2 = 0x8ebc6af09c88c6e3ULL, k3 = 0x589965cc75374cc3ULL;
+    hash64 len  = strlen(s);
+    hash64 seed = hash_mum(k0, k1);
+    hash64 a, b;
+
+    if( len <= 16 )
+    {
+        if( len >= 4 )
+        {
+            hash64 m = (len >> 3) << 2;   // 4 if 8 or more, to cover the middle
+            a = (hash_read(s, 4, FOLD) << 32) | hash_read(s + m, 4, FOLD);
+            b = (hash_read(s + len - 4, 4, FOLD) << 32) |
+                hash_read(s + len - 4 - m, 4, FOLD);
+        } // if
+        else if( len )
+        {
+            a = ((hash64) (unsigned char) s[0] << 16) |
+                ((hash64) (unsigned char) s[len >> 1] << 8) |
+                (unsigned char) s[len - 1];
+            if( FOLD ) a = hash_fold(a);
+            b = 0;
+        } // else if
+        else a = b = 0;
+    } // if
+    else
+    {
+        const char *p = s;
+        hash64      i = len;
+        if( i > 48 )
+        {   // three lanes, no one waiting on another's multiply
+            hash64 see1 = seed, see2 = seed;
+            do
+            {
+                seed = hash_mum(hash_read(p, 8, FOLD) ^ k1, hash_read(p + 8, 8, FOLD) ^ seed);
+                see1 = hash_mum(hash_read(p + 16, 8, FOLD) ^ k2, hash_read(p + 24, 8, FOLD) ^ see1);
+                see2 = hash_mum(hash_read(p + 32, 8, FOLD) ^ k3, hash_read(p + 40, 8, FOLD) ^ see2);
+                p += 48;
+                i -= 48;
+            } while( i > 48 );
+            seed ^= see1 ^ see2;
+        } // if
+        for(; i > 16; p += 16, i -= 16)
+            seed = hash_mum(hash_read(p, 8, FOLD) ^ k1, hash_read(p + 8, 8, FOLD) ^ seed);
+        a = hash_read(p + i - 16, 8, FOLD);
+        b = hash_read(p + i - 8, 8, FOLD);
+    } // else
+
+    a ^= k1;
+    b ^= seed;
+    hash_mul(a, b);
+    return hash_mum(a ^ k0 ^ len, b ^ k1);
+} // hash_wy()
+
+
+// Function : ulong hashwy::operator()(const char *s) const
+// Purpose  : the hashwy hash of the key s
+inline ulong hashwy::operator()(const char *s) const
+{
+    return (ulong) hash_wy<false>(s);
+} // hashwy::operator()()
+
+
+// Function : ulong hashwyfold::operator()(const char *s) const
+// Purpose  : the hashwy hash of the key s, with a-z folded to A-Z
+inline ulong hashwyfold::operator()(const char *s) const
+{
+    return (ulong) hash_wy<true>(s);
+} // hashwyfold::operator()()
+
+
+// Function : ulong hashcase::operator()(const char *s) const
+// Purpose  : the hashwy hash of the key s, with a-z folded if fold
+inline ulong hashcase::operator()(const char *s) const
+{
+    return (ulong) (fold ? hash_wy<true>(s) : hash_wy<false>(s));
+} // hashcase::operator()()
+
+
+// Function : bool hashcase::equal(const char *a, const char *b) const
+// Purpose  : are a and b the same key, but for the case of a-z if fold
+inline bool hashcase::equal(const char *a, const char *b) const
+{
+    return fold ? !strcasecmp(a, b) : !strcmp(a, b);
+} // hashcase::equal()
+
+
 // Function : void chashit< T >::start(void)
 // Purpose  : set iterators back to the start of the table
-template< class T > inline
-  void chashit< T >::start(void)
+template< class T, class H > inline
+  void chashit< T, H >::start(void)
 {
     i         = 0;
     ptr       = 0;
     ihash     = 0;
     offset    = 0;
+    inold     = false;
 } // chashit< T >::start()
 
 
@@ -32,9 +199,10 @@ template< class T > inline
 // Purpose  : to return the next T obj, 
 //            from where ihash + offset are pointing
 // Note     : iteration does -not- take place in T.key() order
-//            it merily walks through the hash array
-template< class T >
-  T *chashit< T >::next(void)
+//            it merily walks through the hash array, then the
+//            buckets of the old array not yet moved, if resizing
+template< class T, class H >
+  T *chashit< T, H >::next(void)
 {
     if( offset )
     { // if we we're in the middle of a linked list, then pick it up there
@@ -44,57 +212,45 @@ template< class T >
         return ptr;             // return last obj
     } // if
 
-    // start incrementing through array, to find used element
-    while( ihash < table.sizeoftable &&
-           !(table.table[ ihash++ ].obj) ) ;
-
-    if( ihash < table.sizeoftable ) 
-    {  // if we found a node then return its value
-        offset = table.table[ihash - 1].next;  // set offset for next call
-        ptr    = table.table[ihash - 1].obj;
-        i++;
-        return ptr;                            // return last obj
-    } // if
-
-    // last element in array still could have values to send
-    if( ihash == table.sizeoftable &&
-        table.table[ table.sizeoftable - 1 ].obj )  
+    for(;;)
     {
-        ihash++;                               // ihash > sizeoftable now
-                                               // set offset for next call
-        offset = table.table[table.sizeoftable - 1].next;
-        ptr    = table.table[table.sizeoftable - 1].obj;
-        i++;
-        return ptr;                            // return last obj
-    } // if
+        const HashNode<T> *nodes = inold ? table.oldtable : table.table;
+        ulong              size  = inold ? table.oldsize  : table.sizeoftable;
+
+        // start incrementing through array, to find used element
+        while( ihash < size && !nodes[ ihash ].obj ) ihash++;
+
+        if( ihash < size )
+        {  // if we found a node then return its value
+            offset = nodes[ihash].next;  // set offset for next call
+            ptr    = nodes[ihash].obj;
+            ihash++;
+            i++;
+            return ptr;                  // return last obj
+        } // if
+
+        if( inold || !table.oldtable )
+            break;
+        inold = true;                    // on to the old buckets not yet moved
+        ihash = table.migrated;
+    } // for
 
+    ptr = 0;
     return 0;  // end of table reached
 } // chashit< T >::next()
 
 
 // Function : template<class T> void HashTable<T>::clr(void)
 // Purpose  : to remove all elements in the HashTable, table is zeroed
-template< class T > void HashTable< T >::clr(void)
+template< class T, class H > void HashTable< T, H >::clr(void)
 {
-    if( sizeoftable > 0 ) // remove HashNode's collision lists
-        for(ihash = 0; ihash < sizeoftable; ihash++)
-        {
-            if( table[ihash].next ) // if a list exists, destory it!
-                for(HashNode< T > *ptr = table[ihash].next; ptr;)
-                {
-                    HashNode< T > *tmp = ptr;  // hold current node for a microsecond
-                    ptr = ptr->next;           // reset to next node
-                    delete tmp;                // now free what was the current node
-                } // for
-        } // for
-
-    // free private HashTable data
-    if( table )
-    { // get rid of all the HashNodes
-        delete [] table;
-        table    = 0;
-    } // if
+    free_nodes(table, sizeoftable, false);
+    free_nodes(oldtable, oldsize, false);
+    table        = 0;
+    oldtable     = 0;
     sizeoftable  = 0;
+    oldsize      = 0;
+    migrated     = 0;
     itemcount    = 0;
     collisions   = 0;
     ihash        = 0;
@@ -105,35 +261,42 @@ template< class T > void HashTable< T >::clr(void)
 // Function : template<class T> void HashTable<T>::free_all(void)
 // Purpose  : to wipe the HashTable, AND FREE ALL OBJECTS MEMORY
 //            same as clr(), except that pointed to objs are also deleted
-template< class T > void HashTable< T >::free_all(void)
+template< class T, class H > void HashTable< T, H >::free_all(void)
+{
+    free_nodes(table, sizeoftable, true);
+    free_nodes(oldtable, oldsize, true);  // moved buckets are empty
+    clr();
+} // free_all()
+
+
+// Function : void HashTable<T>::free_nodes(HashNode<T> *nodes, ulong size, bool objs)
+// Purpose  : free the collision lists of size buckets, deleting the
+//            objects of every bucket if objs, then the bucket array,
+//            unless objs, when nodes may be part of an array
+template< class T, class H >
+  void HashTable< T, H >::free_nodes(HashNode<T> *nodes, ulong size, bool objs)
 {
-    if( sizeoftable > 0 ) // free items pointed to by HashNodes
-        for(ihash = 0; ihash < sizeoftable; ihash++)
+    if( !nodes ) return;
+
+    for(ulong i = 0; i < size; i++)
+    {
+        for(HashNode< T > *ptr = nodes[i].next; ptr;)
         {
-            if( table[ihash].next ) // if a list exists, destory it!
-                for(HashNode< T > *ptr = table[ihash].next; ptr;)
-                {
-                    delete ptr->obj;           // free this nodes object
-                    HashNode< T > *tmp = ptr;  // hold current node for a microsecond
-                    ptr = ptr->next;           // reset to next node
-                    delete tmp;                // now free what was the current node
-                } // for
-            if( table[ ihash ].obj )        // if it exists
-                delete table[ ihash ].obj;  // free table node's object
+            if( objs ) delete ptr->obj;    // free this nodes object
+            HashNode< T > *tmp = ptr;  // hold current node for a microsecond
+            ptr = ptr->next;           // reset to next node
+            delete tmp;                // now free what was the current node
         } // for
+        nodes[i].next = 0;
+        if( objs )
+        {
+            delete nodes[i].obj;       // free table node's object
+            nodes[i].obj = 0;
+        } // if
+    } // for
 
-    // free private HashTable data
-    if( table )
-    { // get rid of all the HashNodes
-        delete [] table;
-        table    = 0;
-    } // if
-    sizeoftable  = 0;
-    itemcount    = 0;
-    collisions   = 0;
-    ihash        = 0;
-    ihash_offset = 0;
-} // free_all()
+    if( !objs ) delete [] nodes;       // get rid of all the HashNodes
+} // free_nodes()
 
 
 // Function : T *HashTable< T >::lookup(const char *x) const
@@ -141,38 +304,49 @@ template< class T > void HashTable< T >::free_all(void)
 //            the key() == x
 // Note     : 'const char *key()' must be a method of class T, key() is the
 //            index into the table via the hash function
+//            while resizing, x is looked for in its old bucket too,
+//            if that hasn't been moved yet
 // Return   : T * - if a object with key() == x was found
 //            0   - if no such object was found
-template <class T> T *HashTable<T>::lookup(const char *x) const
+template <class T, class H> T *HashTable<T, H>::lookup(const char *x) const
 {
+    if( !sizeoftable ) return 0;  // nothing added yet
+
     // locate table position by provided key x
-    HashNode<T> *ptr = &table[ getHashKey(x) ];
+    ulong h   = hashkey(x);
+    T    *obj = find_in(&table[ h % sizeoftable ], x, h);
+    if( !obj && oldtable )
+    {
+        HashNode<T> *old = old_bucket(h);
+        if( old ) obj = find_in(old, x, h);
+    } // if
+
+    return obj;
+} // HashTable<T>::lookup()
+
 
+// Function : T *HashTable< T >::find_in(HashNode<T> *ptr, const char *x, ulong h)
+// Prupose  : to return the first object of bucket ptr with key() == x,
+//            h is hashkey(x), a node of another hash isn't compared
+// Return   : T * - if a object with key() == x was found
+//            0   - if no such object was found
+template <class T, class H>
+  T *HashTable<T, H>::find_in(HashNode<T> *ptr, const char *x, ulong h) const
+{
     // if the item is present compare its' key() to x
     if( ptr->obj )
     {
-
-// distinguish between case and incase sensitive tables here
-#ifdef HASH_INDEX_CASE_SENSITIVE
-        // if they match, we have a winner!
-        if( !strcmp(ptr->obj->key(), x) ) return ptr->obj; 
- 
-        // otherwise search the collison list for a winner
-        for(ptr = ptr->next; ptr; ptr = ptr->next)
-            if( !strcmp(ptr->obj->key(), x) ) return ptr->obj; 
-#else
         // if they match, we have a winner!
-        if( !strcasecmp(ptr->obj->key(), x) ) return ptr->obj; 
+        // the hash policy is case sensitive or not
+        if( ptr->hash == h && hashf.equal(ptr->obj->key(), x) ) return ptr->obj; 
  
         // otherwise search the collison list for a winner
         for(ptr = ptr->next; ptr; ptr = ptr->next)
-            if( !strcasecmp(ptr->obj->key(), x) ) return ptr->obj; 
-#endif
-
+            if( ptr->hash == h && hashf.equal(ptr->obj->key(), x) ) return ptr->obj; 
     } // if
 
-    return 0; // item was not in table
-} // HashTable<T>::lookup()
+    return 0; // item was not in bucket
+} // HashTable<T>::find_in()
 
 /*
 // Function : T *HashTable< T >::search_for_calling()
@@ -184,7 +358,7 @@ template <class T> T *HashTable<T>::lookup(const char *x) const
 //            will be called with a pointer to the instance.
 // Return   : 0 - no instances of 'wild' where found
 //            # of instances of 'wild' found otherwise
-template <class T> uint HashTable<T>::
+template <class T, class H> uint HashTable<T, H>::
   search_for_calling(const char *wild, void (*func)(T *)) const
 {
     // interate table looking was 'wild' matches
@@ -207,8 +381,8 @@ template <class T> uint HashTable<T>::
 //            index into the table via the hash function
 // Returns  : true  - 'x' found in table and deleted
 //            false - 'x' not found in table and not deleted
-template <class T>
-  bool HashTable<T>::remove_del(T *x)
+template <class T, class H>
+  bool HashTable<T, H>::remove_del(T *x)
 {
     if( remove(x) )
     {
@@ -228,11 +402,33 @@ template <class T>
 //            index into the table via the hash function
 // Returns  : true  - 'x' found in table and deleted
 //            false - 'x' not found in table
-template <class T>
-  bool HashTable<T>::remove(const T *x)
+template <class T, class H>
+  bool HashTable<T, H>::remove(const T *x)
 {
-    HashNode<T> *ptr = &table[ getHashKey(x->key()) ]; 
+    if( !sizeoftable ) return false;  // nothing added yet
+    migrate();
+
+    ulong        h   = hashkey(x->key());
+    HashNode<T> *old = 0;
+    if( unlink(&table[ h % sizeoftable ], x) ||
+        ((old = old_bucket(h)) && unlink(old, x)) )
+    {
+        itemcount--;
+        shrink();
+        return true;
+    } // if
+
+    return false;
+}  // HashTable<T>::remove()
+
 
+// Function : bool HashTable< T >::unlink(HashNode<T> *ptr, const T *x)
+// Prupose  : to unlink the obj x from bucket ptr
+// Returns  : true  - 'x' found in bucket and unlinked
+//            false - 'x' not found in bucket
+template <class T, class H>
+  bool HashTable<T, H>::unlink(HashNode<T> *ptr, const T *x)
+{
     // if the item is present compare its' key() to x
     if( ptr->obj )
     {   // if they match, we have a winner!
@@ -243,7 +439,8 @@ template <class T>
                 if( ihash_offset == ptr->next )
                     ihash_offset = ptr->next->next;
                 // decrement collision list from its start
-                ptr->obj = ptr->next->obj;
+                ptr->obj  = ptr->next->obj;
+                ptr->hash = ptr->next->hash;
                 HashNode<T> *tmp = ptr->next;
                 ptr->next = ptr->next->next;
                 delete tmp;
@@ -252,7 +449,6 @@ template <class T>
                 // otherwise it becomes a blank array element
                 ptr->obj = 0;
 
-            itemcount--;
             return true;
         } // if
         else
@@ -265,14 +461,13 @@ template <class T>
                         prior->next = ptr->next;
                     else prior->next = 0;
                     delete ptr;
-                    itemcount--;
                     return true;
                 } // if
         } // else
     } // if
 
     return false;
-}  // HashTable<T>::remove()
+}  // HashTable<T>::unlink()
 
 
 // Function : bool HashTable< T >::remove_del(const char *x)
@@ -280,8 +475,8 @@ template <class T>
 //            AND - FREE IT'S MEMORY -
 // Returns  : true  - 'x' found in table and deleted
 //            false - 'x' not found in table
-template <class T>
-  bool HashTable<T>::remove_del(const char *x)
+template <class T, class H>
+  bool HashTable<T, H>::remove_del(const char *x)
 {
     T *ptr = 0;
 
@@ -302,19 +497,40 @@ template <class T>
 // Returns  : 0 - 'x' not found in table
 //            otherwise address of first T obj found in table
 //             with key() == x; that T obj removed from table
-template <class T>
-  T *HashTable<T>::remove(const char *x)
+template <class T, class H>
+  T *HashTable<T, H>::remove(const char *x)
 {
-    HashNode<T> *ptr = &table[ getHashKey(x) ]; 
+    if( !sizeoftable ) return 0;  // nothing added yet
+    migrate();
+
+    ulong        h   = hashkey(x);
+    HashNode<T> *old = 0;
+    T *obj = unlink(&table[ h % sizeoftable ], x, h);
+    if( !obj && (old = old_bucket(h)) )
+        obj = unlink(old, x, h);
+
+    if( obj )
+    {
+        itemcount--;
+        shrink();
+    } // if
+
+    return obj;
+}  // HashTable<T>::remove()
+
 
+// Function : T *HashTable< T >::unlink(HashNode<T> *ptr, const char *x, ulong h)
+// Prupose  : to unlink the first obj of bucket ptr with key() == x,
+//            h is hashkey(x), a node of another hash isn't compared
+// Returns  : 0 - 'x' not found in bucket
+//            otherwise address of the T obj unlinked
+template <class T, class H>
+  T *HashTable<T, H>::unlink(HashNode<T> *ptr, const char *x, ulong h)
+{
     // if the item is present compare its' key() to x
     if( ptr->obj )
     {   // if they match, we have a winner!
-#ifdef HASH_INDEX_CASE_SENSITIVE
-        if( !strcmp(ptr->obj->key(), x) )
-#else
-        if( !strcasecmp(ptr->obj->key(), x) )
-#endif
+        if( ptr->hash == h && hashf.equal(ptr->obj->key(), x) )
         {
             T *obj = ptr->obj;  // save return value
 
@@ -323,7 +539,8 @@ template <class T>
                 if( ihash_offset == ptr->next )
                     ihash_offset = ptr->next->next;
                 // decrement collision list from its start
-                ptr->obj = ptr->next->obj;
+                ptr->obj  = ptr->next->obj;
+                ptr->hash = ptr->next->hash;
                 HashNode<T> *tmp = ptr->next;
                 ptr->next = ptr->next->next;
                 delete tmp;
@@ -332,41 +549,47 @@ template <class T>
                 // otherwise it becomes a blank array element
                 ptr->obj = 0;
 
-            itemcount--;
             return obj;
         } // if
         else
         {   // otherwise search the collison list for a winner
             HashNode<T> *prior = ptr;
             for(ptr = ptr->next; ptr; prior = ptr, ptr = ptr->next)
-#ifdef HASH_INDEX_CASE_SENSITIVE
-                if( !strcmp(ptr->obj->key(), x) )
-#else
-                if( !strcasecmp(ptr->obj->key(), x) )
-#endif
+                if( ptr->hash == h && hashf.equal(ptr->obj->key(), x) )
                 {
                     if( ptr->next )     // decrement collision list
                         prior->next = ptr->next;
                     else prior->next = 0;
                     T *obj = ptr->obj;  // save return value
                     delete ptr;
-                    itemcount--;
                     return obj;
                 } // if
         } // else
     } // if
 
     return 0;
-}  // HashTable<T>::remove()
+}  // HashTable<T>::unlink()
 
 
 // Function : int HashTable<T>::getHashKey(const char *s) const
 // Purpose  : hash function for indexing to the table[] elments
+// Returns  : the bucket of s in table[], the hash policy's hash of s
+//            modulo the table size
+template< class T, class H >
+int HashTable<T, H>::getHashKey(const char *s) const
+{
+    return( hashkey(s) % sizeoftable );
+}  // HashTable<T>::getHashKey()
+
+
+// Function : ulong hashispell::operator()(const char *s) const
+// Purpose  : hash function for indexing to the table[] elments,
+//            the whole hash, which getHashKey() and old_bucket() take
+//            modulo their bucket array's size
 // Note     : this hash function was taken from the ispell utility
 //            and obviously indexes character strings
 //            -case is NOT preserved in the indexing-
-template< class T >
-int HashTable<T>::getHashKey(const char *s) const
+inline ulong hashispell::operator()(const char *s) const
 {
 
 #define HASHSHIFT   5
@@ -389,14 +612,17 @@ int HashTable<T>::getHashKey(const char *s) const
 	h ^= toupper( *s++ );
     } // while
 
-    return( (ulong) h % sizeoftable );
-}  // HashTable<T>::getHashKey()  
+    return( (ulong) h );
+}  // hashispell::operator()()  
 
 
 // Function : void HashTable< T >::add_to_table(T *new_obj)
 // Purpose  : place a new object (class T) into the hash table
 // Note     : T must have method 'const char *key(void)', which will 
 //            determine new_obj's position in the table
+//            a table with no buckets is given HASH_MIN_SIZE, and one
+//            that would be over max_load() is resize()d to twice
+//            its size first
 // Warning  : it is important to remember that -ONLY A POINTER
 //            IS BEING STORED IN THE TABLE-
 //            therefore, if T is a struct that contains pointers to 
@@ -404,14 +630,30 @@ int HashTable<T>::getHashKey(const char *s) const
 //            copies for those pointers as well as allocate a T
 //            block which -WILL NOT GO OUT OF SCOPE- as soon as the
 //            scope add_to_table() is called from dies
-template < class T > 
-void HashTable< T >::add_to_table(T *new_obj)
+template < class T, class H > 
+void HashTable< T, H >::add_to_table(T *new_obj)
 {
-    // put new_obj in it's place in the hashtable
-    // get its' hash position first
-    HashNode< T > *ptr = &table[ getHashKey(new_obj->key()) ]; 
+    if( !sizeoftable )
+        rehash(HASH_MIN_SIZE);
+    else if( maxload && (itemcount + 1) * 100 > sizeoftable * maxload )
+        resize(sizeoftable * 2);
+    migrate();
 
+    place(new_obj, hashkey(new_obj->key()));
     itemcount++;  // increment the number of items in the table
+} // HashTable::add_to_table()
+
+
+// Function : void HashTable< T >::place(T *new_obj, ulong h)
+// Purpose  : link new_obj, whose key() hashes to h, into its bucket, at
+//            the end of any collision list there, the table must have
+//            buckets, and itemcount is left for the caller
+template < class T, class H > 
+void HashTable< T, H >::place(T *new_obj, ulong h)
+{
+    // put new_obj in it's place in the hashtable
+    // get its' hash position first
+    HashNode< T > *ptr = &table[ h % sizeoftable ]; 
 
     // if obj already exists here, goto plan B - linked lists
     if( ptr->obj )
@@ -422,19 +664,173 @@ void HashTable< T >::add_to_table(T *new_obj)
             for(ptr = ptr->next; ptr; ptr = ptr->next)
                 if( !ptr->next )
                 {   // allocate another node in the linked list
-                    ptr->next = new HashNode< T >;
-                    ptr->next->obj = new_obj; // add y to end of linked list
+                    ptr->next = new HashNode< T >(new_obj, h); // add y to end of linked list
                     break;
                 } // if
         } // if
         else
         { // allocate first node in new linked list
-            ptr->next = new HashNode< T >;
-            ptr->next->obj = new_obj; // add y to start of linked list
+            ptr->next = new HashNode< T >(new_obj, h); // add y to start of linked list
         } // else
     } // if
-    else ptr->obj = new_obj;  // no collision, place in table node 
-} // HashTable::add_to_table()
+    else
+    {   // no collision, place in table node
+        ptr->obj  = new_obj;
+        ptr->hash = h;
+    } // else
+} // HashTable::place()
+
+
+// Function : ulong HashTable< T >::next_prime(ulong n)
+// Purpose  : the table size for a table of n buckets, the first of a
+//            list of primes, each about twice the last, that is at least
+//            n, primes spread getHashKey()'s modulo over every bucket
+// Returns  : the prime, or n made odd past the last of them
+template < class T, class H >
+ulong HashTable< T, H >::next_prime(ulong n)
+{
+    static const ulong primes[] = {
+        11ul, 23ul, 53ul, 97ul, 193ul, 389ul, 769ul, 1543ul, 3079ul, 6151ul,
+        12289ul, 24593ul, 49157ul, 98317ul, 196613ul, 393241ul, 786433ul,
+        1572869ul, 3145739ul, 6291469ul, 12582917ul, 25165843ul, 50331653ul,
+        100663319ul, 201326611ul, 402653189ul, 805306457ul, 1610612741ul,
+        3221225473ul, 4294967291ul };
+
+    for(uint i = 0; i < sizeof(primes) / sizeof(primes[0]); i++)
+        if( primes[i] >= n ) return primes[i];
+
+    return n | 1;
+} // HashTable::next_prime()
+
+
+// Function : ulong HashTable< T >::fit(ulong size) const
+// Purpose  : the size rehash() gives a table asked to be size buckets,
+//            next_prime(size), or of enough buckets to hold the items
+//            within max_load(), if that is more, and at least HASH_MIN_SIZE
+template < class T, class H >
+ulong HashTable< T, H >::fit(ulong size) const
+{
+    if( maxload && size < (itemcount * 100 + maxload - 1) / maxload )
+        size = (itemcount * 100 + maxload - 1) / maxload;
+    if( size < HASH_MIN_SIZE ) size = HASH_MIN_SIZE;
+    return next_prime(size);
+} // HashTable::fit()
+
+
+// Function : void HashTable< T >::rehash(ulong size)
+// Purpose  : move every item into a new table of fit(size) buckets,
+//            at once, finishing any incremental resize first
+// Note     : the items keep their collision list order, relative to
+//            the other items of the same new bucket
+//            the collision counter is counted again for the new table
+template < class T, class H >
+void HashTable< T, H >::rehash(ulong size)
+{
+    finish();
+    size = fit(size);
+
+    HashNode< T > *old     = table;
+    ulong          count   = sizeoftable;
+
+    table        = new HashNode< T >[size];
+    sizeoftable  = size;
+    collisions   = 0;
+    ihash        = 0;
+    ihash_offset = 0;
+
+    oldtable = old;     // moved all at once
+    oldsize  = count;
+    migrated = 0;
+    migrate(count);
+} // HashTable::rehash()
+
+
+// Function : void HashTable< T >::resize(ulong size)
+// Purpose  : grow or shrink the table to fit(size) buckets, by
+//            rehash() if set_incremental() is 0, otherwise by setting
+//            the bucket array aside as the old table, to be moved to
+//            the new one a step at a time by migrate()
+// Note     : nothing is done while a chashit is on the table, the
+//            next add_to_table() or remove..() after it tries again
+//            an incremental resize still under way is finished first
+template < class T, class H >
+void HashTable< T, H >::resize(ulong size)
+{
+    if( iterators ) return;   // hold still under a chashit
+    if( !step ) { rehash(size); return; }
+
+    finish();
+    size = fit(size);
+    if( size == sizeoftable ) return;
+
+    oldtable     = table;
+    oldsize      = sizeoftable;
+    migrated     = 0;
+    table        = new HashNode< T >[size];
+    sizeoftable  = size;
+    collisions   = 0;
+    ihash        = 0;
+    ihash_offset = 0;
+} // HashTable::resize()
+
+
+// Function : void HashTable< T >::migrate(ulong buckets)
+// Purpose  : move the items of up to buckets more old buckets to the
+//            table, in order, and free the old table once all are moved
+// Note     : only the mutators call it, lookup() leaves the old
+//            buckets be, so a const table is never written
+template < class T, class H >
+void HashTable< T, H >::migrate(ulong buckets)
+{
+    for(; buckets && migrated < oldsize; buckets--, migrated++)
+    {
+        HashNode< T > &b = oldtable[migrated];
+        if( b.obj ) place(b.obj, b.hash);
+        for(HashNode< T > *ptr = b.next; ptr;)
+        {
+            HashNode< T > *tmp = ptr;  // hold current node for a microsecond
+            ptr = ptr->next;
+            place(tmp->obj, tmp->hash);
+            delete tmp;
+        } // for
+        b.obj  = 0;
+        b.next = 0;
+    } // for
+
+    if( oldtable && migrated == oldsize )
+    {   // all moved
+        delete [] oldtable;
+        oldtable = 0;
+        oldsize  = 0;
+        migrated = 0;
+    } // if
+} // HashTable::migrate()
+
+
+// Function : HashNode<T> *HashTable< T >::old_bucket(ulong h) const
+// Purpose  : the bucket of the old table keys of hash h were in, while resizing
+// Returns  : 0 if not resizing, or that old bucket has been moved
+template < class T, class H >
+HashNode<T> *HashTable< T, H >::old_bucket(ulong h) const
+{
+    if( !oldtable ) return 0;
+    ulong b = h % oldsize;
+    if( b < migrated ) return 0;
+    return &oldtable[b];
+} // HashTable::old_bucket()
+
+
+// Function : void HashTable< T >::shrink(void)
+// Purpose  : resize() the table, if a remove..() has left it under
+//            min_load(), to a size it fills to half of max_load(),
+//            or to half its size if it never grows
+template < class T, class H >
+void HashTable< T, H >::shrink(void)
+{
+    if( minload && sizeoftable > HASH_MIN_SIZE &&
+        itemcount * 100 < sizeoftable * minload )
+        resize(maxload ? itemcount * 200 / maxload : sizeoftable / 2);
+} // HashTable::shrink()
 
 
 } // namespace blib
@@ -4,7 +4,8 @@
 
 // File     : hash.h
 // Purpose  : define HashTable template class
-// Contains : class HashTable, class Node
+// Contains : class HashTable, class Node, the hash policies hashwy,
+//            hashwyfold, hashcase and hashispell
 //
 // Update Log:
 //
@@ -12,6 +13,13 @@
 // 19990628 - added HashTable::search_for_calling()
 // 19991116 - refined the remove..() functions
 // 20090527 - appended #endif comment
+// 20261017 - added growth by load factor, reserve(), rehash(), and shrinking by set_min_load()
+// 20261017 - added the incremental rehash of set_incremental(), a table isn't rehashed while a chashit is on it
+// 20261017 - the hash function is a policy, HashTable<T, H>, hashwy or hashwyfold by default, hashispell as before
+// 20261017 - HashNode keeps the hash of its obj's key(), so lookups pass other keys' nodes without calling key()
+// 20261017 - the hash policy compares the keys too, by equal(), replacing HASH_INDEX_CASE_SENSITIVE, added hashcase
+// 20261017 - lookup() no longer moves old buckets, and the chashit count is atomic, so a const table is
+//            only read, and can be shared by concurrent readers
 
 
 #ifndef HASH_CLASS_DEFINITION
@@ -20,6 +28,9 @@
 
 #pragma warning(disable:4786)
 #include <string>   // string class
+#include <cstring>  // for strcmp()
+#include <strings.h>  // for strcasecmp()
+#include <atomic>     // for the chashit count
 #include "blib.h"   // blib global prototypes, defines, etc
 
 
@@ -29,19 +40,111 @@ namespace blib
 
 // prototypes
 template <class T> struct HashNode;
-template <class T> class  HashTable;
-template <class T> class  chashit;
+template <class T, class H> class HashTable;
+template <class T, class H> class chashit;
+struct hashwy;
+struct hashwyfold;
+struct hashcase;
+struct hashispell;
+
+
+// add_to_table() grows a table, to the next of its prime sizes, once it
+//  would hold more than this many items per hundred buckets, 0 never grows
+#define  HASH_MAX_LOAD   100
+
+// remove..() shrinks a table once it holds fewer than this many items per
+//  hundred buckets, 0 never shrinks, keep it well under HASH_MAX_LOAD / 2
+#define  HASH_MIN_LOAD   0
+
+// fewest buckets a table is grown, shrunk or rehash()ed to
+#define  HASH_MIN_SIZE   11
+
+// old buckets each add_to_table() and remove..() moves to the new table
+//  while a table is growing or shrinking, 0 moves them all at once, the
+//  default for set_incremental()
+#define  HASH_INCREMENTAL_STEP  0
+
+
+// Struct  : struct hashwy
+// Purpose : the hash policy of a HashTable, a 64 bit hash of the wyhash
+//           kind, 8 characters at a time, every bit of the key reaches
+//           every bit of the hash, so keys that differ only in a digit
+//           or two at the end, "host.metric.N", spread over the table
+// Note    : a policy H is called as h(key), and returns a ulong, which
+//           HashTable takes modulo its size, and h.equal(a, b) is true
+//           if keys a and b are the same key, which must hash alike,
+//           so a policy is a table's case sensitivity too
+//           keys over 48 characters are hashed 48 at a time, by three
+//           independent multiplies, which a CPU runs side by side
+//           -case IS preserved in the hashing-, and in equal(), strcmp()
+struct hashwy
+{
+    ulong operator()(const char *) const;
+    bool  equal(const char *a, const char *b) const
+        { return !strcmp(a, b); }
+}; // struct hashwy
+
+
+// Struct  : struct hashwyfold
+// Purpose : hashwy of the key with a-z folded to A-Z, 8 characters at a
+//           time without a branch, and equal() strcasecmp(), for a case
+//           insensitive table
+// Note    : libc's strcasecmp() folds and compares many characters at a
+//           time, and is the faster, keys are only compared once their
+//           hashes match, so a key the locale folds further than a-z
+//           is still found only by the same case of those characters
+struct hashwyfold
+{
+    ulong operator()(const char *) const;
+    bool  equal(const char *a, const char *b) const
+        { return !strcasecmp(a, b); }
+}; // struct hashwyfold
+
+
+// Struct  : struct hashcase
+// Purpose : hashwy or hashwyfold, chosen when the table is made, so one
+//           table type serves case sensitive and insensitive tables,
+//           HashTable<T, hashcase> t(size, hashcase(true)) folds case
+// Note    : each call tests fold, which always goes the same way, so
+//           it costs a predicted branch over the fixed policies
+struct hashcase
+{
+    bool fold;   // case insensitive if true
+
+    hashcase(bool f = false) : fold(f) {}
+    ulong operator()(const char *) const;
+    bool  equal(const char *, const char *) const;
+}; // struct hashcase
+
+
+// Struct  : struct hashispell
+// Purpose : the hash HashTable had before hash policies, a rotate and xor
+//           of the toupper()ed characters, taken from ispell
+// Note    : it keeps little of the characters before the last few, so
+//           keys sharing a long prefix fall in few buckets, kept for
+//           tables that depend on its order
+//           equal() is strcmp(), as HASH_INDEX_CASE_SENSITIVE was set,
+//           the hash folds case, so a table may fold in equal() or not
+struct hashispell
+{
+    ulong operator()(const char *) const;
+    bool  equal(const char *a, const char *b) const
+        { return !strcmp(a, b); }
+}; // struct hashispell
 
 
-// if you would like the hash table indexing to be
-//  Case-Sensitive uncomment the next line
-#define  HASH_INDEX_CASE_SENSITIVE
+// the hash policy of a HashTable<T>, case sensitive, hashwyfold or
+//  hashcase for a case insensitive table
+typedef hashwy  hashdefault;
 
 
 // Struct  : struct HashNode
 // Purpose : is an element of the hash array, obj points to the data
 // Note    : class T must have this method 'const char *key(void)'
 //           add_to_table() adds the new items at getHashKey( T.key() ) position
+//           hash is the table's whole hash of obj->key(), a lookup only
+//           calls key() and compares it on a node whose hash matches,
+//           and a rehash moves the node without hashing the key again
 template< class T > struct HashNode
 {
     T *obj;          // pointer to data for this node
@@ -49,9 +152,11 @@ template< class T > struct HashNode
                      // HashTable methods determine node usage by obj != 0
     HashNode *next;  // pointer to next node in this element's 
                      // linked list (for collisions)
+    ulong hash;      // hash of obj->key(), by the table's hash policy
     // constructors
-    HashNode(void) : obj(0), next(0) {}
-    HashNode(T *y) : obj(y), next(0) {}
+    HashNode(void) : obj(0), next(0), hash(0) {}
+    HashNode(T *y) : obj(y), next(0), hash(0) {}
+    HashNode(T *y, ulong h) : obj(y), next(0), hash(h) {}
 }; // template struct HashNote
 
 
@@ -59,7 +164,25 @@ template< class T > struct HashNode
 // Purpose : hash table container for HashNode elements
 // Note    : class T must have this method 'const char *key(void)'
 //           add_to_table() adds the new items at getHashKey( T.key() ) position
-template< class T > class HashTable
+//           H is the hash policy, h(key) the hash of a key, hashdefault
+//           unless given, getHashKey() is h(key) modulo the size
+//           a table grows by itself past max_load() items per hundred
+//           buckets, and shrinks under min_load(), to a prime size, as
+//           getHashKey() is taken modulo the size, init_hashtable() gives
+//           a table the exact size asked for, as before
+//           with set_incremental(n) a table grows or shrinks a few
+//           buckets at a time, the old bucket array is kept beside the
+//           new one, and each add_to_table() and remove..() moves n
+//           more of its buckets over, until none are left, so no one
+//           call pays for the whole rehash, lookup() looks in both
+//           a table is not grown or shrunk while a chashit is on it, nor
+//           are buckets moved, it catches up once the last chashit is gone
+//           the const methods, lookup() and chashit only read the table,
+//           chashit counts itself atomically, so concurrent readers may
+//           share a table, as long as nothing changes it meanwhile
+// Warning : rehash(), reserve() and init_hashtable() move or drop every
+//           item at once, a chashit on the table must be start()ed again
+template< class T, class H = hashdefault > class HashTable
 {
     protected:
         // protected data -  accessable by derived classes
@@ -67,8 +190,33 @@ template< class T > class HashTable
     ulong       sizeoftable;   // the number of items in the array
 	ulong       collisions;    // number of collisions in table
 	ulong       itemcount;     // number of items in table
-
-    friend class chashit<T>;
+	uint        maxload;       // grow past this many items per hundred buckets, 0 never
+	uint        minload;       // shrink under this many items per hundred buckets, 0 never
+	uint        step;          // old buckets moved per call, 0 to rehash at once
+	HashNode<T> *oldtable;     // bucket array being moved out of, 0 if none
+	ulong       oldsize;       // buckets in oldtable
+	ulong       migrated;      // oldtable buckets already moved
+	mutable std::atomic<uint> iterators;  // chashits on the table, which hold back moves
+	H             hashf;       // the hash policy
+
+    friend class chashit<T, H>;
+
+	ulong hashkey(const char *x) const      // the whole hash, before the modulo
+	    { return hashf(x); }
+	ulong fit(ulong) const;                 // the prime size rehash() gives for a size
+	void place(T *, ulong);                 // link an item of this hash into its bucket, without growing
+	void resize(ulong);                     // grow or shrink, at once or by step
+	void shrink(void);                      // resize smaller, if under minload
+	void migrate(ulong);                    // move up to so many old buckets
+	void finish(void)                       // move every old bucket
+	    { if( oldtable ) migrate(oldsize); }
+	void migrate(void)                      // a call's step of moves
+	    { if( oldtable && !iterators ) migrate(step); }
+	HashNode<T> *old_bucket(ulong) const;   // a hash's oldtable bucket, 0 if moved or none
+	T *find_in(HashNode<T> *, const char *, ulong) const;  // first item with the key, of this hash, in a bucket
+	T *unlink(HashNode<T> *, const char *, ulong);         // unlink the first item with the key from a bucket
+	bool unlink(HashNode<T> *, const T *);          // unlink the item from a bucket
+	static void free_nodes(HashNode<T> *, ulong, bool);  // free a bucket array, and its items if asked
 
     public:
 	ulong         ihash;         // used as table iterator
@@ -76,9 +224,18 @@ template< class T > class HashTable
 
         // constructors & desctructor
         HashTable(void) : table(0), sizeoftable(0), collisions(0), 
-            itemcount(0), ihash(0), ihash_offset(0)  {}
+            itemcount(0), maxload(HASH_MAX_LOAD), minload(HASH_MIN_LOAD),
+            step(HASH_INCREMENTAL_STEP), oldtable(0), oldsize(0), migrated(0),
+            iterators(0), hashf(), ihash(0), ihash_offset(0)  {}
 	HashTable(ulong size) : table(0), sizeoftable(0),
-	    collisions(0), itemcount(0), ihash(0), ihash_offset(0)
+	    collisions(0), itemcount(0), maxload(HASH_MAX_LOAD),
+	    minload(HASH_MIN_LOAD), step(HASH_INCREMENTAL_STEP), oldtable(0),
+	    oldsize(0), migrated(0), iterators(0), hashf(), ihash(0), ihash_offset(0)
+	    { init_hashtable(size); }
+	HashTable(ulong size, H h) : table(0), sizeoftable(0),
+	    collisions(0), itemcount(0), maxload(HASH_MAX_LOAD),
+	    minload(HASH_MIN_LOAD), step(HASH_INCREMENTAL_STEP), oldtable(0),
+	    oldsize(0), migrated(0), iterators(0), hashf(h), ihash(0), ihash_offset(0)
 	    { init_hashtable(size); }
         ~HashTable(void) { clr(); }
 
@@ -88,7 +245,17 @@ template< class T > class HashTable
             // inits table to size Hashnodes
             // warning: clears any previous records
             { clr(); sizeoftable = size; table = new HashNode< T >[size]; }
-        void add_to_table(T *);
+        void add_to_table(T *);         // grows the table first, if it would be over max_load()
+	void rehash(ulong);             // move every item into a table of at least this many buckets, a prime
+	void reserve(ulong n)           // grow the table, if need be, to hold n items within max_load()
+	    { if( maxload ) n = (n * 100 + maxload - 1) / maxload;
+	      if( n > sizeoftable ) rehash(n); }
+	void set_max_load(uint percent) // items per hundred buckets to grow past, 0 never grows
+	    { maxload = percent; }
+	void set_min_load(uint percent) // items per hundred buckets to shrink under, 0 never shrinks
+	    { minload = percent; }
+	void set_incremental(uint buckets)  // old buckets moved per call while resizing, 0 resizes at once
+	    { step = buckets; if( !step ) finish(); }
 	void clr(void);        // Destroys all nodes within index, HashTable zeroed
 	void free_all(void);   // same as clr() but also DELETES OBJECTS
 
@@ -98,7 +265,7 @@ template< class T > class HashTable
 	bool remove_del(const char *);
 
         // inspectors
-	int getHashKey(const char *) const;   // the actual hash function
+	int getHashKey(const char *) const;   // the bucket of a key, by the hash policy
 	int getHashKey(const string &x) const 
 	    { return getHashKey( x.c_str() ); }
 
@@ -115,6 +282,13 @@ template< class T > class HashTable
             { return itemcount; }
         ulong numberofcollisions(void) const  // return the collision counter
             { return collisions; }
+        uint max_load(void) const             // return the growth load, in items per hundred buckets
+            { return maxload; }
+        uint min_load(void) const             // return the shrink load, in items per hundred buckets
+            { return minload; }
+        bool rehashing(void) const            // are buckets still to be moved from an old table?
+            { return oldtable != 0; }
+        static ulong next_prime(ulong);       // the table size rehash() gives for a size
 }; // template class HashTable
 
 
@@ -125,19 +299,26 @@ template< class T > class HashTable
 //            into the table by the hashing function
 // Example  : for(chashit<obj> i(objtable); ++i;)
 //                i()->whatever();
-template <class T> class chashit
+// Note     : a table of another hash policy needs it given here too,
+//            chashit<obj, hashispell>
+template <class T, class H = hashdefault> class chashit
 {
     private:
         T                  *ptr;       // pointer to current T obj
         uint               i;          // maintains iterative count
         HashNode<T>        *offset;    // collision list offset
-        uint               ihash;      // maintains table position
-        const HashTable<T> &table;     // table to iterate
+        ulong              ihash;      // maintains table position
+        bool               inold;      // walking the old buckets of a table being resized
+        const HashTable<T, H> &table;  // table to iterate
 
     public:
-        // constructor
-        chashit(const HashTable<T> &t) : table(t)
-          { start(); }
+        // constructors & destructor, the table isn't resized while a chashit is on it
+        chashit(const HashTable<T, H> &t) : table(t)
+          { table.iterators++; start(); }
+        chashit(const chashit<T, H> &a) : ptr(a.ptr), i(a.i), offset(a.offset),
+          ihash(a.ihash), inold(a.inold), table(a.table)
+          { table.iterators++; }
+        ~chashit(void) { table.iterators--; }
 
         // mutators
         void start(void);          // start iteration over again
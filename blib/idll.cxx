@@ -0,0 +1,615 @@
+/*****************************************************************************/
+/*** Software: AMOS v0.01 (c)1998 All Rights Reserved by Bradley B. Custer ***/
+/*****************************************************************************/
+
+// File    : idll.cxx
+// Purpose : contains template function members of idllist class (idll.h)
+//
+// Update Log -
+//
+// 20261017 - Begun
+
+
+// intrusive doublely-linked list class header
+#include "idll.h"
+
+
+namespace blib
+{
+
+
+// Template : void idllist<T,H>::link_before(T *a, T *at)
+// Purpose  : links unlisted object 'a' into the ring just
+//            before 'at', or makes 'a' the whole ring if
+//            the list is empty, does not touch head or length
+template <class T, dllhook<T> T::*H>
+void idllist<T,H>::link_before(T *a, T *at)
+{
+    dllhook<T> &h = hook(a);
+    h.owner = this;
+    if( !at )
+    {   h.next  = a;
+        h.prior = a;
+        return;
+    } // if
+    h.next  = at;
+    h.prior = hook(at).prior;
+    hook(h.prior).next = a;
+    hook(at).prior     = a;
+} // template idllist<T,H>::link_before()
+
+
+// Template : void idllist<T,H>::unlink(T *a)
+// Purpose  : takes listed object 'a' out of the ring,
+//            fixing head and length, and clears its hook
+template <class T, dllhook<T> T::*H>
+void idllist<T,H>::unlink(T *a)
+{
+    dllhook<T> &h = hook(a);
+    if( --length )
+    {   hook(h.prior).next = h.next;
+        hook(h.next).prior = h.prior;
+        if( head == a ) head = h.next;
+    } // if
+    else head = 0;
+    h.next = h.prior = 0;
+    h.owner = 0;
+} // template idllist<T,H>::unlink()
+
+
+// Template : T *idllist<T,H>::node_num(const uint) const
+// Purpose  : find the i-th object, walking from
+//            whichever end of the list is nearer
+// Note     : i must be < length
+template <class T, dllhook<T> T::*H>
+T *idllist<T,H>::node_num(const uint i) const
+{
+    T *ptr = head;
+    if( i <= length / 2 )
+        for(uint j = 0; j < i; j++) ptr = hook(ptr).next;
+    else
+        for(uint j = length; j > i; j--) ptr = hook(ptr).prior;
+    return ptr;
+} // template idllist<T,H>::node_num()
+
+
+// Template : uint idllist<T,H>::add(T *a)
+// Purpose  : add 'a' at the end of the list
+// Returns  : 0 if 'a' is already in a list (by this hook)
+//            new legnth of list otherwise
+template <class T, dllhook<T> T::*H>
+uint idllist<T,H>::add(T *a)
+{
+    if( !a || hook(a).linked() ) return 0;
+    link_before(a, head);
+    if( !head ) head = a;
+    return ++length;
+} // template idllist<T,H>::add()
+
+
+// Template : uint idllist<T,H>::push(T *a)
+// Purpose  : add 'a' at the beginning of the list
+// Returns  : 0 if 'a' is already in a list (by this hook)
+//            new legnth of list otherwise
+template <class T, dllhook<T> T::*H>
+uint idllist<T,H>::push(T *a)
+{
+    if( !add(a) ) return 0;
+    // the ring is circular, so the new last object
+    //  becomes the first just by moving head
+    head = a;
+    return length;
+} // template idllist<T,H>::push()
+
+
+// Template : uint idllist<T,H>::add_num(T *a, uint num)
+// Purpose  : add 'a' at the num-th position of the list
+//            the old num-th object moves down one position
+//            'num' is taken to be zero starting
+// Returns  : 0 if 'a' is already in a list (by this hook)
+//            new legnth of list otherwise
+// Note     : if num >= length, 'a' becomes the end
+template <class T, dllhook<T> T::*H>
+uint idllist<T,H>::add_num(T *a, uint num)
+{
+    if( num >= length ) return add(a);
+    if( !num ) return push(a);
+    if( !a || hook(a).linked() ) return 0;
+    link_before(a, node_num(num));
+    return ++length;
+} // template idllist<T,H>::add_num()
+
+
+// Template : void idllist<T,H>::append_and_purge(idllist<T,H> &a)
+// Purpose  : moves every object of 'a' onto the end of *this,
+//            leaving 'a' empty, the rings are spliced in O(1)
+//            but each moved object's hook must be told its new
+//            owner, so this is O(a.size())
+template <class T, dllhook<T> T::*H>
+void idllist<T,H>::append_and_purge(idllist<T,H> &a)
+{
+    if( !a.length || &a == this ) return;
+    T *ptr = a.head;
+    for(uint i = a.length; i--; ptr = hook(ptr).next)
+        hook(ptr).owner = this;
+
+    if( !length ) head = a.head;
+    else
+    {   T *last   = hook(head).prior;
+        T *a_last = hook(a.head).prior;
+        hook(last).next    = a.head;
+        hook(a.head).prior = last;
+        hook(a_last).next  = head;
+        hook(head).prior   = a_last;
+    } // else
+    length  += a.length;
+    a.head   = 0;
+    a.length = 0;
+} // template idllist<T,H>::append_and_purge()
+
+
+// Template : void idllist<T,H>::prepend_and_purge(idllist<T,H> &a)
+// Purpose  : moves every object of 'a' onto the beginning of *this,
+//            leaving 'a' empty, O(a.size()) for the same reason
+//            as append_and_purge()
+template <class T, dllhook<T> T::*H>
+void idllist<T,H>::prepend_and_purge(idllist<T,H> &a)
+{
+    if( !a.length || &a == this ) return;
+    T *a_head = a.head;
+    append_and_purge(a);
+    head = a_head;  // it's a ring, so only the head moves
+} // template idllist<T,H>::prepend_and_purge()
+
+
+// Template : bool idllist<T,H>::pop(void)
+// Purpose  : remove the head of the list
+// Returns  : TRUE if successful, and head removed
+//            FALSE if there was nothing in the list
+template <class T, dllhook<T> T::*H>
+bool idllist<T,H>::pop(void)
+{
+    if( !length ) return false;
+    unlink(head);
+    return true;
+} // template idllist<T,H>::pop()
+
+
+// Template : bool idllist<T,H>::pop_delete(void)
+// Purpose  : remove the head of the list and DELETE it
+// Returns  : TRUE if successful, and head removed
+//            FALSE if there was nothing in the list
+template <class T, dllhook<T> T::*H>
+bool idllist<T,H>::pop_delete(void)
+{
+    if( !length ) return false;
+    T *tmp = head;
+    unlink(tmp);
+    delete tmp;
+    return true;
+} // template idllist<T,H>::pop_delete()
+
+
+// Template : bool idllist<T,H>::remove(T *a)
+// Purpose  : removes 'a' from the list in O(1), the object
+//            knows its own neighbors so there is no search
+//            does NOT DELETE 'a'
+// Returns  : FALSE if 'a' isn't in *this
+//            TRUE otherwise
+template <class T, dllhook<T> T::*H>
+bool idllist<T,H>::remove(T *a)
+{
+    if( !in_list(a) ) return false;
+    unlink(a);
+    return true;
+} // template idllist<T,H>::remove()
+
+
+// Template : bool idllist<T,H>::remove_delete(T *a)
+// Purpose  : removes 'a' from the list in O(1), and DELETES it
+// Returns  : FALSE if 'a' isn't in *this
+//            TRUE otherwise
+template <class T, dllhook<T> T::*H>
+bool idllist<T,H>::remove_delete(T *a)
+{
+    if( !in_list(a) ) return false;
+    unlink(a);
+    delete a;
+    return true;
+} // template idllist<T,H>::remove_delete()
+
+
+// Template : bool idllist<T,H>::remove(const T& a)
+// Purpose  : removes first object equal to 'a', comparing
+//            with T::operator==(), does NOT DELETE it
+// Returns  : FALSE if no object equal to 'a' was found
+//            TRUE otherwise
+template <class T, dllhook<T> T::*H>
+bool idllist<T,H>::remove(const T& a)
+{
+    T *found = ref_in_list(a);
+    if( !found ) return false;
+    unlink(found);
+    return true;
+} // template idllist<T,H>::remove()
+
+
+// Template : bool idllist<T,H>::remove_delete(const T& a)
+// Purpose  : removes first object equal to 'a', comparing
+//            with T::operator==(), and DELETES it
+// Returns  : FALSE if no object equal to 'a' was found
+//            TRUE otherwise
+template <class T, dllhook<T> T::*H>
+bool idllist<T,H>::remove_delete(const T& a)
+{
+    T *found = ref_in_list(a);
+    if( !found ) return false;
+    unlink(found);
+    delete found;
+    return true;
+} // template idllist<T,H>::remove_delete()
+
+
+// Template : bool idllist<T,H>::remove_last(void)
+// Purpose  : remove the end of the list, does NOT DELETE it
+// Returns  : TRUE if successful, and last removed
+//            FALSE if there was nothing in the list
+template <class T, dllhook<T> T::*H>
+bool idllist<T,H>::remove_last(void)
+{
+    if( !length ) return false;
+    unlink(hook(head).prior);
+    return true;
+} // template idllist<T,H>::remove_last()
+
+
+// Template : bool idllist<T,H>::remove_last_delete(void)
+// Purpose  : remove the end of the list, and DELETE it
+// Returns  : TRUE if successful, and last removed
+//            FALSE if there was nothing in the list
+template <class T, dllhook<T> T::*H>
+bool idllist<T,H>::remove_last_delete(void)
+{
+    if( !length ) return false;
+    T *tmp = hook(head).prior;
+    unlink(tmp);
+    delete tmp;
+    return true;
+} // template idllist<T,H>::remove_last_delete()
+
+
+// Template : bool idllist<T,H>::remove_num(uint num)
+// Purpose  : removes num-th object, num is zero starting
+//            does NOT DELETE it
+// Returns  : FALSE if num >= length
+//            TRUE otherwise
+template <class T, dllhook<T> T::*H>
+bool idllist<T,H>::remove_num(uint num)
+{
+    if( num >= length ) return false;
+    unlink(node_num(num));
+    return true;
+} // template idllist<T,H>::remove_num()
+
+
+// Template : bool idllist<T,H>::remove_num_delete(uint num)
+// Purpose  : removes num-th object, num is zero starting
+//            and DELETES it
+// Returns  : FALSE if num >= length
+//            TRUE otherwise
+template <class T, dllhook<T> T::*H>
+bool idllist<T,H>::remove_num_delete(uint num)
+{
+    if( num >= length ) return false;
+    T *tmp = node_num(num);
+    unlink(tmp);
+    delete tmp;
+    return true;
+} // template idllist<T,H>::remove_num_delete()
+
+
+// Template : void idllist<T,H>::purge(void)
+// Purpose  : removes every object from the list, clearing
+//            each hook so the objects can be listed again
+//            does NOT DELETE the objects
+template <class T, dllhook<T> T::*H>
+void idllist<T,H>::purge(void)
+{
+    T *ptr = head;
+    while( length-- )
+    {
+        dllhook<T> &h = hook(ptr);
+        ptr = h.next;
+        h.next = h.prior = 0;
+        h.owner = 0;
+    } // while
+    head = 0; length = 0;
+} // template idllist<T,H>::purge()
+
+
+// Template : void idllist<T,H>::free_all(void)
+// Purpose  : removes and DELETES every object in the list
+template <class T, dllhook<T> T::*H>
+void idllist<T,H>::free_all(void)
+{
+    T *ptr = head;
+    while( length-- )
+    {
+        T *tmp = ptr;
+        ptr = hook(ptr).next;
+        hook(tmp).owner = 0;
+        delete tmp;
+    } // while
+    head = 0; length = 0;
+} // template idllist<T,H>::free_all()
+
+
+// Template : uint idllist<T,H>::sort(void)
+// Purpose  : sorts the list greatest-to-least comparing
+//            objects with T::operator<()
+// Returns  : number of comparisons performed for sort
+// Note     : see merge_sort()
+template <class T, dllhook<T> T::*H>
+uint idllist<T,H>::sort(void)
+{
+    return merge_sort( [](T *a, T *b) { return *a < *b; } );
+} // template idllist<T,H>::sort()
+
+
+// Template : uint idllist<T,H>::sort_dll(void)
+// Purpose  : sorts the list greatest-to-least comparing
+//            objects with T::dll_lessthan(const T *)
+// Returns  : number of comparisons performed for sort
+// Note     : see merge_sort()
+template <class T, dllhook<T> T::*H>
+uint idllist<T,H>::sort_dll(void)
+{
+    return merge_sort( [](T *a, T *b) { return a->dll_lessthan(b); } );
+} // template idllist<T,H>::sort_dll()
+
+
+// Template : uint idllist<T,H>::sort(bool (*)())
+// Purpose  : sorts the list greatest-to-least comparing
+//            objects with the function 'lt'
+// Returns  : number of comparisons performed for sort
+// Note     : see merge_sort()
+template <class T, dllhook<T> T::*H>
+uint idllist<T,H>::sort(bool (*lt)(const T *, const T *))
+{
+    return merge_sort( [lt](const T *a, const T *b) { return (*lt)(a, b); } );
+} // template idllist<T,H>::sort(bool (*))
+
+
+// Template : uint idllist<T,H>::merge_sort(LT lt)
+// Purpose  : stable natural merge sort of the list, greatest-to-least,
+//            the same algorithm as dllist<T>::merge_sort(), run on
+//            the hooks' next pointers, with the prior pointers
+//            restored in one last pass
+// Returns  : number of comparisons performed for sort
+template <class T, dllhook<T> T::*H> template <class LT>
+uint idllist<T,H>::merge_sort(LT lt)
+{
+    if( length < 2 ) return 0;
+
+    uint comparisons = 0;
+
+    T    *runs[33];   // runs[k] is the merge of 2^k runs, or 0
+    uint levels = 0;  // number of runs[] in use
+
+    hook(hook(head).prior).next = 0;  // open the ring
+    T *rest = head;
+    while( rest )
+    {
+        // peel the next natural run off the front of rest
+        T *run = rest, *tail = rest;
+        rest = hook(rest).next;
+        if( rest )
+        {
+            comparisons++;
+            if( lt(tail, rest) )
+            {   // strictly ascending, so collect it reversed
+                hook(tail).next = 0;
+                do
+                {   T *tmp = hook(rest).next;
+                    hook(rest).next = run;
+                    run             = rest;
+                    rest            = tmp;
+                } while( rest && (++comparisons, lt(run, rest)) );
+            } // if
+            else
+            {   // greatest-to-least already, equal objects stay in order
+                do
+                {   tail = rest;
+                    rest = hook(rest).next;
+                } while( rest && (++comparisons, !lt(tail, rest)) );
+                hook(tail).next = 0;
+            } // else
+        } // if
+
+        // carry the run up, every runs[k] holds objects from before 'run'
+        uint k = 0;
+        for(; k < levels && runs[k]; k++)
+        {
+            run     = merge_chains(runs[k], run, lt, comparisons);
+            runs[k] = 0;
+        } // for
+        if( k == levels ) levels++;
+        runs[k] = run;
+    } // while
+
+    // merge what's left, higher levels hold the earlier objects
+    T *sorted = 0;
+    for(uint k = 0; k < levels; k++)
+        if( runs[k] )
+            sorted = sorted ? merge_chains(runs[k], sorted, lt, comparisons) : runs[k];
+
+    // restore prior pointers and close the ring
+    head = sorted;
+    T *prior = head;
+    for(T *tmp = hook(head).next; tmp; tmp = hook(tmp).next)
+    {
+        hook(tmp).prior = prior;
+        prior           = tmp;
+    } // for
+    hook(prior).next = head;
+    hook(head).prior = prior;
+
+    return comparisons;
+} // template idllist<T,H>::merge_sort()
+
+
+// Template : T *idllist<T,H>::merge_chains(a, b, lt, comparisons)
+// Purpose  : merges two 0 terminated, greatest-to-least chains,
+//            on equal objects 'a' goes first
+// Returns  : head of the merged chain
+template <class T, dllhook<T> T::*H> template <class LT>
+T *idllist<T,H>::merge_chains(T *a, T *b, LT &lt, uint &comparisons)
+{
+    T *merged = 0, **tail = &merged;
+    while( a && b )
+    {
+        comparisons++;
+        if( lt(a, b) )
+        {   *tail = b;  // b is greater, it goes first
+            tail  = &hook(b).next;
+            b     = hook(b).next;
+        } // if
+        else
+        {   *tail = a;
+            tail  = &hook(a).next;
+            a     = hook(a).next;
+        } // else
+    } // while
+    *tail = a ? a : b;
+    return merged;
+} // template idllist<T,H>::merge_chains()
+
+
+// Template : T *idllist<T,H>::ref_in_list(const T &a)
+// Purpose  : find an object equal to 'a' using T::operator==()
+// Returns  : pointer to first equal object in *this
+//            0 if not found
+template <class T, dllhook<T> T::*H>
+T *idllist<T,H>::ref_in_list(const T &a) const
+{
+    for(cidllit<T,H> i(*this); !i.finished(); ++i)
+        if( *i() == a ) return i();
+
+    return 0;  // 'a' wasn't found
+} // template idllist<T,H>::ref_in_list()
+
+
+// Template : T *idllist<T,H>::match_in_list(const string& str)
+// Purpose  : find a match using T::matches(const string& str)
+// Returns  : pointer to first matched object in *this
+//            0 if not found
+template <class T, dllhook<T> T::*H>
+T *idllist<T,H>::match_in_list(const string& str) const
+{
+    for(cidllit<T,H> i(*this); !i.finished(); ++i)
+        if( i()->matches(str) ) return i();
+
+    return 0;  // match wasn't found
+} // template idllist<T,H>::match_in_list()
+
+
+// Template : T *idllist<T,H>::match_in_list(const string& str1, const string& str2)
+// Purpose  : find a match using T::matches(const string&, const string&)
+// Returns  : pointer to first matched object in *this
+//            0 if not found
+template <class T, dllhook<T> T::*H>
+T *idllist<T,H>::match_in_list(const string& str1, const string& str2) const
+{
+    for(cidllit<T,H> i(*this); !i.finished(); ++i)
+        if( i()->matches(str1, str2) ) return i();
+
+    return 0;  // match wasn't found
+} // template idllist<T,H>::match_in_list()
+
+
+// Template : T *idllist<T,H>::match_in_list(const int num)
+// Purpose  : find a match using T::matches(const int num)
+// Returns  : pointer to first matched object in *this
+//            0 if not found
+template <class T, dllhook<T> T::*H>
+T *idllist<T,H>::match_in_list(const int num) const
+{
+    for(cidllit<T,H> i(*this); !i.finished(); ++i)
+        if( i()->matches(num) ) return i();
+
+    return 0;  // match wasn't found
+} // template idllist<T,H>::match_in_list()
+
+
+// Template : T *idllist<T,H>::match_in_list(const uint num)
+// Purpose  : find a match using T::matches(const uint num)
+// Returns  : pointer to first matched object in *this
+//            0 if not found
+template <class T, dllhook<T> T::*H>
+T *idllist<T,H>::match_in_list(const uint num) const
+{
+    for(cidllit<T,H> i(*this); !i.finished(); ++i)
+        if( i()->matches(num) ) return i();
+
+    return 0;  // match wasn't found
+} // template idllist<T,H>::match_in_list()
+
+
+// Template : T *idllist<T,H>::match_in_list(const double num)
+// Purpose  : find a match using T::matches(const double& num)
+// Returns  : pointer to first matched object in *this
+//            0 if not found
+template <class T, dllhook<T> T::*H>
+T *idllist<T,H>::match_in_list(const double num) const
+{
+    for(cidllit<T,H> i(*this); !i.finished(); ++i)
+        if( i()->matches(num) ) return i();
+
+    return 0;  // match wasn't found
+} // template idllist<T,H>::match_in_list()
+
+
+// Template : uint idllit<T,H>::remove(void)
+// Purpose  : removes the object the iterator is pointing to,
+//            does NOT DELETE it
+// Returns  : new legnth of list, 0 if list is (now) empty
+// Notes    : iterator moves to the object AFTER the one removed,
+//            step_made is handled as in dllit<T>::remove(), so
+//            a loop removing objects should skip its ++ after
+//            a remove, as in
+//            for(idllit<T,H> i(list); !i.done();)
+//              if( -something- ) i.remove(); else ++i;
+template <class T, dllhook<T> T::*H>
+uint idllit<T,H>::remove(void)
+{
+    if( !list.length || !ptr ) return 0;
+    T *tmp = (ptr->*H).next;
+    bool resetting_head = (ptr == list.head);
+    list.unlink(ptr);
+    ptr = list.length ? tmp : 0;
+    if( !list.length ) i = 0;
+    else if( i >= list.length ) i = 0;  // was the last object, now pointing at head
+    if( !resetting_head ) step_made = true;
+    return list.length;
+} // template idllit<T,H>::remove()
+
+
+// Template : uint idllit<T,H>::remove_delete(void)
+// Purpose  : removes the object the iterator is pointing to,
+//            and DELETES it
+// Returns  : new legnth of list, 0 if list is (now) empty
+// Notes    : same as remove()
+template <class T, dllhook<T> T::*H>
+uint idllit<T,H>::remove_delete(void)
+{
+    if( !list.length || !ptr ) return 0;
+    T *old = ptr;
+    uint left = remove();
+    delete old;
+    return left;
+} // template idllit<T,H>::remove_delete()
+
+
+} // namespace blib
+
+// idll.cxx
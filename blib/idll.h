@@ -0,0 +1,258 @@
+/*****************************************************************************/
+/*** Software: AMOS v0.01 (c)1998 All Rights Reserved by Bradley B. Custer ***/
+/*****************************************************************************/
+
+// File    : idll.h
+// Purpose : contains templates for an intrusive doublely-linked list ADT
+//           idllist links objects through a dllhook member of the
+//           objects themselves, so no list node is ever allocated
+//
+// Update Log -
+//
+// 20261017 - Begun, with the same method names as dllist
+
+
+#ifndef INTRUSIVE_DOUBLELY_LINKED_LIST_TEMPLATE
+#define INTRUSIVE_DOUBLELY_LINKED_LIST_TEMPLATE
+
+
+#include <string>
+#include "blib.h"    // blib defines
+
+
+using std::string;
+
+
+namespace blib
+{
+
+
+// prototypes
+template <class T> struct dllhook;
+template <class T, dllhook<T> T::*H> class idllist;
+template <class T, dllhook<T> T::*H> class idllit;
+template <class T, dllhook<T> T::*H> class cidllit;
+
+
+// Template : struct dllhook
+// Purpose  : the links of an object in an idllist, to be a
+//            member of the object, e.g.
+//              struct Rec { string name; dllhook<Rec> hook; };
+//              idllist<Rec, &Rec::hook> recs;
+//            an object can be in as many idllists at once as
+//            it has dllhook members, but in only one list per hook
+// Note     : copying an object does not copy its links, the copy
+//            starts out in no list, and assigning to an object
+//            leaves it in whatever list it was in
+//            an object MUST BE REMOVED from its list before it is
+//            destructed, or the list will point to a dead object
+template <class T> struct dllhook
+{
+    T          *next;   // next object in the list, 0 if in no list
+    T          *prior;  // prior object in the list
+    const void *owner;  // idllist this object is in, 0 if none
+
+    // constructors
+    dllhook(void) : next(0), prior(0), owner(0) {}
+    dllhook(const dllhook<T> &) : next(0), prior(0), owner(0) {}
+    dllhook<T> &operator=(const dllhook<T> &) { return *this; }
+
+    // inspectors
+    bool linked(void) const { return owner != 0; }  // is the object in a list?
+}; // template struct dllhook
+
+
+// Template: class idllist
+// Purpose : intrusive doublely-linked list, with the dllist method names
+//           the list is a ring through the H member of its objects,
+//           so adding costs no allocation, iterating costs one pointer
+//           load per object, and remove(const T*) is O(1) since the
+//           object already knows its neighbors
+// Warning : just like dllist, when the list is purged, deleted, or has
+//           any object removed the object IS NOT DELETED, use free_all()
+//           or the *_delete() methods to delete the objects
+//           unlike dllist, an object can't be in one list twice, nor
+//           can a list be copied, since the links live in the objects
+template <class T, dllhook<T> T::*H> class idllist
+{
+    private:
+        T    *head;    // first object in list
+        uint length;   // length of list
+
+        friend class idllit<T,H>;
+        friend class cidllit<T,H>;
+
+        static dllhook<T> &hook(T *a) { return a->*H; }
+        static const dllhook<T> &hook(const T *a) { return a->*H; }
+
+        void link_before(T *, T *);  // put an unlinked object before a listed one
+        void unlink(T *);            // take an object out of *this
+        T   *node_num(uint) const;   // return i-th object (i < length)
+
+        // stable natural merge sort, greatest-to-least, by an object less-than
+        template <class LT> uint merge_sort(LT);
+        template <class LT> static T *merge_chains(T *, T *, LT &, uint &);
+
+        // not copyable, the links are in the objects
+        idllist(const idllist<T,H> &);
+        void operator=(const idllist<T,H> &);
+
+    public:
+        // constructors
+        idllist() : head(0), length(0) {}
+        // destructor
+        ~idllist() { purge(); }  // this only unlinks the objects, does not delete them
+
+        // mutators
+        void append_and_purge(idllist<T,H> &);   // move arguement's objects onto end of *this, leaving arguement empty
+        void prepend_and_purge(idllist<T,H> &);  // move arguement's objects onto beginning of *this, leaving arguement empty
+        uint push(T *);                      // adds object at beginning of list, 0 if it was already in a list
+        uint add(T *);                       // adds object at end of list, 0 if it was already in a list
+        uint add_num(T *, uint);             // adds object in i-th position, 0 if it was already in a list
+        bool pop(void);                      // removes first object from list, does not delete it
+        bool pop_delete(void);               // removes first object from list, and DELETES it
+        bool remove(T *);                    // removes object from list in O(1), false if not in *this, does not delete it
+        bool remove_delete(T *);             // removes object from list in O(1), false if not in *this, DELETES it
+        bool remove(const T&);               // removes first object equal to arg. by T::operator==(), does not delete it
+        bool remove_delete(const T&);        // removes first object equal to arg. by T::operator==(), DELETES it
+        bool remove_last(void);              // removes last object from list, does not delete it
+        bool remove_last_delete(void);       // removes last object from list, and DELETES it
+        bool remove_num(uint);               // removes i-th object from list, does not delete it
+        bool remove_num_delete(uint);        // removes i-th object from list, and DELETES it
+        void purge(void);                    // removes every object from the list, does not delete them
+        void free_all(void);                 // removes and DELETES every object in the list
+        uint sort(void);                     // sorts the list greast-to-least with T::operator<(const T&)
+        uint sort_dll(void);                 // sorts the list greast-to-least with T::dll_lessthan(const T*)
+        uint sort(bool (*)(const T*, const T*));
+
+        // inspectors
+        bool in_list(const T *a) const             // report if argument is in *this, in O(1)
+            { return a && hook(a).owner == this; }
+        T* ref_in_list(const T&) const;            // return 1st match to argument in list, comparing with T::operator==()
+        T* match_in_list(const string&) const;                 // return 1st match to string key in list, comparing with "bool T::matches(const string&) const"
+        T* match_in_list(const string&, const string&) const;  // return 1st match to string keys in list, comparing with "bool T::matches(const string&, const string&) const"
+        T* match_in_list(const int) const;                     // report if a match to int key is in list, comparing with T::matches(const int)
+        T* match_in_list(const uint) const;                    // report if a match to uint key is in list, comparing with T::matches(const uint)
+        T* match_in_list(const double) const;                  // return 1st match to double key in list, comparing with "bool T::matches(const double&) const"
+        T& operator[](uint i) const                // return reference to ith object
+            { return *get_num(i); }
+        T* get_num(const uint i) const             // return pointer to ith object, 0 if past end
+            { if( i < length ) return node_num(i); return 0; }
+        T* first(void) const                       // return head object
+            { return head; }
+        T* last(void) const                        // return last object
+            { if( length ) return hook(head).prior; else return 0; }
+        T* next(const T *a) const                  // return object after argument, 0 at end of list
+            { T *n = hook(a).next; return n == head ? 0 : n; }
+        T* prior(const T *a) const                 // return object before argument, 0 at start of list
+            { return a == head ? 0 : hook(a).prior; }
+        bool empty(void) const                     // report if list is empty
+            { if( length ) return false; else return true; }
+        uint size(void) const { return length; }    // report size of list
+}; // template class idllist
+
+
+// Template : class idllit
+// Purpose  : iterator class for idllist, used just as dllit
+//            for(idllit<T,H> i(list); !i.finished(); ++i) ;
+template <class T, dllhook<T> T::*H> class idllit
+{
+    private:
+        T             *ptr;       // current object
+        idllist<T,H>  &list;      // list being iterated
+        bool          step_made;  // flags whether iteration has begun
+        uint          i;          // maintains iterative position
+
+    public:
+        // constructor
+        idllit(idllist<T,H> &L) : ptr(L.head), list(L), step_made(false), i(0) {}
+
+        // mutators
+        void start(void)           // start iteration over again
+            { ptr = list.head; step_made = false; i = 0; }
+        void start_at(const uint& s)  // same as start() then s ++'s, positions past the end wrap around
+            { start(); if( !list.length || !s ) return;
+              i = s % list.length; ptr = list.node_num(i); step_made = true; }
+        T *operator++(void)        // increment object being pointed to
+            { if( ptr ) ptr = (ptr->*H).next; step_made = true;
+              if( ptr == list.head ) i = 0; else i++;
+              return ptr; }
+        T *operator--(void)        // decrement object being pointed to
+            { if( ptr ) ptr = (ptr->*H).prior; step_made = true;
+              if( ptr && ptr == (list.head->*H).prior ) i = list.length - 1; else i--;
+              return ptr; }
+        uint remove(void);         // remove current object from list, does NOT DELETE it, iterator moves to next object
+        uint remove_delete(void);  // remove current object from list, WILL DELETE it, iterator moves to next object
+
+        // inspectors
+        uint num(void) const       // return iteration position
+            { return i; }
+        T *operator()(void) const  // inspect object interator is pointing to
+            { return ptr; }
+        bool at_start(void) const  // is iterator pointing to first object?
+            { if( list.length ) return ptr == list.head; return false; }
+        bool at_end(void) const    // is iterator pointing to last object?
+            { if( list.length ) return ptr == (list.head->*H).prior; return true; }
+        bool finished(void) const  // has a full list iteration occured ?
+            { if( list.length )
+              { if( step_made ) return ptr == list.head; else return false; }
+              return true; }
+        bool done(void) const      // second name for finished()
+            { return finished(); }
+}; // template class idllit
+
+
+// Template : class cidllit
+// Purpose  : const iterator class for idllist, used just as cdllit
+template <class T, dllhook<T> T::*H> class cidllit
+{
+    private:
+        T                   *ptr;       // current object
+        const idllist<T,H>  &list;      // list being iterated
+        bool                step_made;  // flags whether iteration has begun
+        uint                i;          // maintains iterative position
+
+    public:
+        // constructor
+        cidllit(const idllist<T,H> &L) : ptr(L.head), list(L), step_made(false), i(0) {}
+
+        // mutators
+        void start(void)           // start iteration over again
+            { ptr = list.head; step_made = false; i = 0; }
+        void start_at(const uint& s)  // same as start() then s ++'s, positions past the end wrap around
+            { start(); if( !list.length || !s ) return;
+              i = s % list.length; ptr = list.node_num(i); step_made = true; }
+        T *operator++(void)        // increment object being pointed to
+            { if( ptr ) ptr = (ptr->*H).next; step_made = true;
+              if( ptr == list.head ) i = 0; else i++;
+              return ptr; }
+        T *operator--(void)        // decrement object being pointed to
+            { if( ptr ) ptr = (ptr->*H).prior; step_made = true;
+              if( ptr && ptr == (list.head->*H).prior ) i = list.length - 1; else i--;
+              return ptr; }
+
+        // inspectors
+        uint num(void) const       // return iteration position
+            { return i; }
+        T *operator()(void) const  // inspect object interator is pointing to
+            { return ptr; }
+        bool at_start(void) const  // is iterator pointing to first object?
+            { if( list.length ) return ptr == list.head; return false; }
+        bool at_end(void) const    // is iterator pointing to last object?
+            { if( list.length ) return ptr == (list.head->*H).prior; return true; }
+        bool finished(void) const  // has a full list iteration occured ?
+            { if( list.length )
+              { if( step_made ) return ptr == list.head; else return false; }
+              return true; }
+        bool done(void) const      // second name for finished()
+            { return finished(); }
+}; // template class cidllit
+
+
+} // namespace blib
+
+#include "idll.cxx"   // included b/c idllist is a set of template classes, not compilable itself
+
+#endif // INTRUSIVE_DOUBLELY_LINKED_LIST_TEMPLATE
+
+// idll.h
@@ -0,0 +1,248 @@
+/*****************************************************************************/
+/*** Software: AMOS v0.01 (c)1998 All Rights Reserved by Bradley B. Custer ***/
+/*****************************************************************************/
+
+// File    : rcudll.cxx
+// Purpose : contains template function members of rcudllist and
+//           rcusnap classes (rcudll.h)
+//
+// Update Log -
+//
+// 20261017 - Begun
+
+
+// read-copy-update doublely-linked list class header
+#include "rcudll.h"
+
+#include <sched.h>    // for sched_yield()
+
+
+namespace blib
+{
+
+
+// Template : rcudllist<T>::rcudllist(void)
+// Purpose  : start with an empty version published
+template <class T> rcudllist<T>::rcudllist(void) : current(new dllist<T>)
+{
+    pthread_mutex_init(&writing, 0);
+}  // template rcudllist<T>::rcudllist()
+
+
+// Template : rcudllist<T>::~rcudllist(void)
+// Purpose  : free the current and every retired version
+// Note     : no reader may be holding a snapshot
+template <class T> rcudllist<T>::~rcudllist(void)
+{
+    for(uint k = 0; k < retired.size(); k++)
+        delete retired[k];
+    delete current.load();
+    pthread_mutex_destroy(&writing);
+}  // template rcudllist<T>::~rcudllist()
+
+
+// Template : bool rcudllist<T>::in_use(const dllist<T> *v) const
+// Purpose  : is version 'v' named by any reader's hazard slot?
+template <class T>
+bool rcudllist<T>::in_use(const dllist<T> *v) const
+{
+    for(uint k = 0; k < RCUDLL_READER_SLOTS; k++)
+        if( slots[k].version.load() == v )
+            return true;
+    return false;
+}  // template rcudllist<T>::in_use()
+
+
+// Template : void rcudllist<T>::publish(dllist<T> *next)
+// Purpose  : make 'next' the version new snapshots get, retire the
+//            version it replaces, and free what retired versions
+//            the readers have let go of
+// Note     : the writers' mutex must be held
+template <class T>
+void rcudllist<T>::publish(dllist<T> *next)
+{
+    // the exchange comes before free_retired() reads the slots, and a
+    //  reader fills its slot before checking that the version it took
+    //  is still current, so one of the two sees the other
+    retired.push_back(current.exchange(next));
+    free_retired();
+}  // template rcudllist<T>::publish()
+
+
+// Template : uint rcudllist<T>::free_retired(void)
+// Purpose  : free each retired version no hazard slot names
+// Returns  : number of versions still retired
+// Note     : the writers' mutex must be held
+template <class T>
+uint rcudllist<T>::free_retired(void)
+{
+    uint kept = 0;
+    for(uint k = 0; k < retired.size(); k++)
+    {
+        if( in_use(retired[k]) ) retired[kept++] = retired[k];
+        else delete retired[k];  // gives back the nodes no later version shares
+    } // for
+    retired.resize(kept);
+    return kept;
+}  // template rcudllist<T>::free_retired()
+
+
+// Template : void rcudllist<T>::update(F f)
+// Purpose  : publish a new version, made by calling f(dllist<T>&)
+//            on a copy of the current version
+// Note     : writers take turns, readers are never blocked,
+//            f must not take a snapshot of *this, or write to it
+template <class T> template <class F>
+void rcudllist<T>::update(F f)
+{
+    pthread_mutex_lock(&writing);
+    dllist<T> *next = new dllist<T>(*current.load());
+    f(*next);
+    publish(next);
+    pthread_mutex_unlock(&writing);
+}  // template rcudllist<T>::update()
+
+
+// Template : void rcudllist<T>::assign(const dllist<T> &a)
+// Purpose  : publish a copy of 'a' as the new version
+template <class T>
+void rcudllist<T>::assign(const dllist<T> &a)
+{
+    pthread_mutex_lock(&writing);
+    publish(new dllist<T>(a));
+    pthread_mutex_unlock(&writing);
+}  // template rcudllist<T>::assign()
+
+
+// Template : uint rcudllist<T>::add(T *newvalue)
+// Purpose  : publish a new version with newvalue added to the end
+// Returns  : 0 node allocation failed
+//            new legnth of list otherwise
+template <class T>
+uint rcudllist<T>::add(T *newvalue)
+{
+    pthread_mutex_lock(&writing);
+    dllist<T> *next = new dllist<T>(*current.load());
+    uint len = next->add(newvalue);
+    publish(next);
+    pthread_mutex_unlock(&writing);
+    return len;
+}  // template rcudllist<T>::add()
+
+
+// Template : uint rcudllist<T>::push(T *newvalue)
+// Purpose  : publish a new version with newvalue added to the front
+// Returns  : 0 node allocation failed
+//            new legnth of list otherwise
+template <class T>
+uint rcudllist<T>::push(T *newvalue)
+{
+    pthread_mutex_lock(&writing);
+    dllist<T> *next = new dllist<T>(*current.load());
+    uint len = next->push(newvalue);
+    publish(next);
+    pthread_mutex_unlock(&writing);
+    return len;
+}  // template rcudllist<T>::push()
+
+
+// Template : bool rcudllist<T>::remove(const T *oldvalue)
+// Purpose  : publish a new version without the first oldvalue,
+//            comparing pointer values, does not delete T object
+// Returns  : true -- oldvalue was found and removed from list
+//            false -- oldvalue was not found, nothing is published
+template <class T>
+bool rcudllist<T>::remove(const T *oldvalue)
+{
+    pthread_mutex_lock(&writing);
+    bool found = current.load()->in_list(oldvalue);
+    if( found )
+    {   dllist<T> *next = new dllist<T>(*current.load());
+        next->remove(oldvalue);
+        publish(next);
+    } // if
+    pthread_mutex_unlock(&writing);
+    return found;
+}  // template rcudllist<T>::remove()
+
+
+// Template : void rcudllist<T>::purge(void)
+// Purpose  : publish an empty version
+template <class T>
+void rcudllist<T>::purge(void)
+{
+    pthread_mutex_lock(&writing);
+    publish(new dllist<T>);
+    pthread_mutex_unlock(&writing);
+}  // template rcudllist<T>::purge()
+
+
+// Template : uint rcudllist<T>::reclaim(void)
+// Purpose  : free the retired versions no reader holds now,
+//            without waiting for the next writer to do it
+// Returns  : number of versions still held by readers
+template <class T>
+uint rcudllist<T>::reclaim(void)
+{
+    pthread_mutex_lock(&writing);
+    uint kept = free_retired();
+    pthread_mutex_unlock(&writing);
+    return kept;
+}  // template rcudllist<T>::reclaim()
+
+
+// Template : uint rcudllist<T>::size(void) const
+// Purpose  : return the length of the current version
+// Note     : another writer may have changed it by the time this returns
+template <class T>
+uint rcudllist<T>::size(void) const
+{
+    rcusnap<T> s(*this);
+    return s->size();
+}  // template rcudllist<T>::size()
+
+
+// Template : bool rcudllist<T>::reclaimed(void) const
+// Purpose  : have all the replaced versions been freed?
+template <class T>
+bool rcudllist<T>::reclaimed(void) const
+{
+    pthread_mutex_lock(&writing);
+    bool none = retired.empty();
+    pthread_mutex_unlock(&writing);
+    return none;
+}  // template rcudllist<T>::reclaimed()
+
+
+// Template : rcusnap<T>::rcusnap(const rcudllist<T> &L)
+// Purpose  : take a hazard slot of L and hold L's current version in it
+// Note     : each thread starts looking at a slot of its own, so
+//            readers do not contend for one slot's cache line, and
+//            yields after every full pass over taken slots
+template <class T> rcusnap<T>::rcusnap(const rcudllist<T> &L)
+{
+    static std::atomic<uint> threads(0);
+    static thread_local uint home = threads++ % RCUDLL_READER_SLOTS;
+
+    for(uint k = home, tries = 1;; k = (k + 1) % RCUDLL_READER_SLOTS, tries++)
+    {
+        std::atomic<const dllist<T> *> &s = L.slots[k].version;
+        const dllist<T> *v = L.current.load(), *none = 0;
+        if( s.compare_exchange_strong(none, v) )
+        {   // v may have been retired and freed before it was in the
+            //  slot, if it is still current that can't have happened
+            if( L.current.load() == v )
+            {   version = v;
+                slot = &s;
+                return;
+            } // if
+            s.store(0);
+        } // if
+        if( tries % RCUDLL_READER_SLOTS == 0 ) sched_yield();
+    } // for
+}  // template rcusnap<T>::rcusnap()
+
+
+} // namespace blib
+
+// rcudll.cxx
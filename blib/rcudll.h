@@ -0,0 +1,150 @@
+/*****************************************************************************/
+/*** Software: AMOS v0.01 (c)1998 All Rights Reserved by Bradley B. Custer ***/
+/*****************************************************************************/
+
+// File    : rcudll.h
+// Purpose : contains templates for a read-copy-update dllist,
+//           rcudllist publishes immutable versions of a dllist
+//           which any number of threads read without a lock,
+//           while writers take turns making the next version
+//
+// Update Log -
+//
+// 20261017 - Begun, with rcusnap<T> reader snapshots and hazard slots
+
+
+#ifndef READ_COPY_UPDATE_DOUBLELY_LINKED_LIST_TEMPLATE
+#define READ_COPY_UPDATE_DOUBLELY_LINKED_LIST_TEMPLATE
+
+
+#include <atomic>      // for the published version and the hazard slots
+#include <vector>      // for the retired versions
+#include <pthread.h>   // for the writers' mutex
+#include "blib.h"      // blib defines
+#include "dll.h"       // the versions are dllist<T>s
+
+
+namespace blib
+{
+
+
+// prototypes
+template <class T> class rcudllist;
+template <class T> class rcusnap;
+
+
+// number of readers which may hold a snapshot of one rcudllist at once,
+//  a reader finding every slot taken yields until one is given back
+#define  RCUDLL_READER_SLOTS  64
+
+
+// Template : struct rcuslot
+// Purpose  : a hazard slot, the version a reader is reading, 0 if free,
+//            padded so that readers in neighbouring slots do not share
+//            a cache line
+template <class T> struct rcuslot
+{
+    std::atomic<const dllist<T> *> version;
+    char pad[64 - sizeof(std::atomic<const dllist<T> *>)];
+
+    rcuslot(void) : version(0) {}
+}; // template struct rcuslot
+
+
+// Template: class rcudllist
+// Purpose : a dllist<T> shared by many reading threads and updated by
+//           few, readers take an rcusnap<T> and iterate it with cdllit<T>
+//           as they would any const dllist, without a lock, and always
+//           see one whole version, writers each copy the current version,
+//           change the copy and publish it in its place
+// Note    : the copy is made with dllist<T>::operator=(), which shares
+//           the nodes, so the copy is O(1), and the writer's first change
+//           to it copies the nodes, leaving the readers' version as it was
+//           a replaced version is freed once no reader's hazard slot
+//           names it any longer, by the next writer or by reclaim()
+// Note    : readers must not use positional access on a snapshot
+//           (operator[], get_num(), start_at()), it moves the list's
+//           cursor, which the other readers of the version share
+// Warning : as with dllist, the values pointed to are not the list's,
+//           a value removed by a writer may still be read by a reader
+//           holding an older snapshot, so it must not be deleted until
+//           reclaimed() says no older snapshot is left
+template <class T> class rcudllist
+{
+    private:
+        std::atomic<const dllist<T> *> current;   // the published version
+        mutable rcuslot<T> slots[RCUDLL_READER_SLOTS];  // readers' hazard slots
+        std::vector<const dllist<T> *> retired;    // replaced versions not yet freed
+        mutable pthread_mutex_t writing;           // held by the writer
+
+        friend class rcusnap<T>;
+
+        bool in_use(const dllist<T> *) const;  // does a hazard slot name this version?
+        void publish(dllist<T> *);             // make the argument the current version
+        uint free_retired(void);               // reclaim(), with the writers' mutex held
+
+        // copying a published list would copy versions readers hold
+        rcudllist(const rcudllist<T> &);
+        void operator=(const rcudllist<T> &);
+
+    public:
+        // constructor
+        rcudllist(void);
+        // destructor
+        ~rcudllist(void);  // frees every version, no reader may hold a snapshot, does not delete values
+
+        // mutators, each publishes a new version
+        template <class F>
+        void update(F);                      // F(dllist<T>&) changes a copy of the current version
+        void assign(const dllist<T> &);      // the new version is a copy of the argument
+        uint add(T *);                       // add a list element to the end of the list
+        uint push(T *);                      // add a list element to the front of the list
+        bool remove(const T *);              // removes first oldvalue from list comparing pointer values
+        void purge(void);                    // the new version is empty
+        uint reclaim(void);                  // free the retired versions no reader holds, returns how many are left
+
+        // inspectors
+        uint size(void) const;               // length of the current version
+        bool reclaimed(void) const;          // are all replaced versions freed?
+}; // template class rcudllist
+
+
+// Template: class rcusnap
+// Purpose : a reader's hold on the current version of an rcudllist,
+//           the version will not change or be freed while it is held
+// Useage  : rcusnap<T> s(list);
+//           for(cdllit<T> i(*s); !i.finished(); ++i) ..
+// Note    : a snapshot should be held only for as long as a read takes,
+//           the versions replaced meanwhile can't be freed until then
+template <class T> class rcusnap
+{
+    private:
+        const dllist<T> *version;                  // version held
+        std::atomic<const dllist<T> *> *slot;      // hazard slot holding it
+
+        // a snapshot owns its slot, so it is not copied
+        rcusnap(const rcusnap<T> &);
+        void operator=(const rcusnap<T> &);
+
+    public:
+        // constructor
+        rcusnap(const rcudllist<T> &);
+        // destructor
+        ~rcusnap(void)  // give back the slot
+            { slot->store(0, std::memory_order_release); }
+
+        // inspectors
+        const dllist<T> &operator*(void) const
+            { return *version; }
+        const dllist<T> *operator->(void) const
+            { return version; }
+}; // template class rcusnap
+
+
+} // namespace blib
+
+#include "rcudll.cxx"   // included b/c rcudllist is a set of template classes, not compilable itself
+
+#endif // READ_COPY_UPDATE_DOUBLELY_LINKED_LIST_TEMPLATE
+
+// rcudll.h
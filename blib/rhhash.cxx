@@ -0,0 +1,319 @@
+/*****************************************************************************/
+/*** Software: AMOS v0.01 (c)1998 All Rights Reserved by Bradley B. Custer ***/
+/*****************************************************************************/
+
+// File   : rhhash.cxx
+// Purpse : contains templated methods for class RHHashTable< T >
+//
+// Update Log -
+//
+// 20261017 - Begun
+// 20261017 - find() compares keys by the hash policy's equal(), not by HASH_INDEX_CASE_SENSITIVE
+
+
+namespace blib
+{
+
+
+// Function : T *rhhashit< T >::next(void)
+// Purpose  : to return the next T obj, from the next used slot
+// Note     : iteration does -not- take place in T.key() order
+//            it merily walks through the slot array
+template< class T, class H >
+  T *rhhashit< T, H >::next(void)
+{
+    while( slot < table.sizeoftable )
+        if( (ptr = table.table[ slot++ ].obj) )
+        {
+            i++;
+            return ptr;
+        } // if
+
+    ptr = 0;
+    return 0;  // end of table reached
+} // rhhashit< T >::next()
+
+
+// Function : uint RHHashTable<T>::getHashKey(const char *s)
+// Purpose  : hash function for the keys of the table, a FNV-1a hash
+//            with a final mix, so its low bits, which pick the home
+//            slot, depend on every character
+// Note     : -case is NOT preserved in the hashing-, so the table may
+//            compare keys either way, as its hash policy's equal() does
+template< class T, class H >
+uint RHHashTable<T, H>::getHashKey(const char *s)
+{
+    uint h = 2166136261u;
+    for(; *s; s++)
+    {
+        uint c = (unsigned char) *s;
+        c -= (c - 'a' < 26u) << 5;   // fold a-z to A-Z, without a branch
+        h = (h ^ c) * 16777619u;
+    } // for
+
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}  // RHHashTable<T>::getHashKey()
+
+
+// Function : void RHHashTable<T>::init_hashtable(ulong size)
+// Purpose  : clr() the table and give it size slots, rounded up to a
+//            power of two, at least RHHASH_MIN_SIZE
+template< class T, class H >
+void RHHashTable<T, H>::init_hashtable(ulong size)
+{
+    clr();
+    ulong slots = RHHASH_MIN_SIZE;
+    while( slots < size ) slots <<= 1;
+    table       = new RHHashSlot<T>[slots];
+    sizeoftable = slots;
+} // RHHashTable<T>::init_hashtable()
+
+
+// Function : template<class T> void RHHashTable<T>::clr(void)
+// Purpose  : to remove all elements in the RHHashTable, table is zeroed
+template< class T, class H > void RHHashTable< T, H >::clr(void)
+{
+    delete [] table;
+    table       = 0;
+    sizeoftable = 0;
+    itemcount   = 0;
+    collisions  = 0;
+} // clr()
+
+
+// Function : template<class T> void RHHashTable<T>::free_all(void)
+// Purpose  : to wipe the RHHashTable, AND FREE ALL OBJECTS MEMORY
+//            same as clr(), except that pointed to objs are also deleted
+template< class T, class H > void RHHashTable< T, H >::free_all(void)
+{
+    for(ulong i = 0; i < sizeoftable; i++)
+        delete table[i].obj;
+    clr();
+} // free_all()
+
+
+// Function : void RHHashTable<T>::place(T *obj, uint hash)
+// Purpose  : put obj, whose key hashes to hash, in the table, which
+//            must have an empty slot, taking the slot of any value
+//            nearer its home than obj is to its own, and placing that
+//            value further on in turn
+template< class T, class H >
+void RHHashTable<T, H>::place(T *obj, uint hash)
+{
+    ulong pos  = hash & mask();
+    ulong dist = 0;
+
+    for(;; pos = (pos + 1) & mask(), dist++)
+    {
+        RHHashSlot<T> &s = table[pos];
+        if( !s.obj )
+        {
+            s.obj  = obj;
+            s.hash = hash;
+            if( dist ) collisions++;
+            return;
+        } // if
+
+        ulong d = distance(pos);
+        if( d < dist )
+        {   // the richer value gives up its slot, and moves on
+            if( d ) collisions--;      // counted again where it lands
+            collisions++;              // obj is past its home, d < dist
+            T   *o = s.obj;   s.obj  = obj;   obj  = o;
+            uint h = s.hash;  s.hash = hash;  hash = h;
+            dist = d;
+        } // if
+    } // for
+} // RHHashTable<T>::place()
+
+
+// Function : void RHHashTable<T>::grow(ulong slots)
+// Purpose  : move every value into a new table of slots slots
+template< class T, class H >
+void RHHashTable<T, H>::grow(ulong slots)
+{
+    RHHashSlot<T> *old  = table;
+    ulong         count = sizeoftable;
+
+    table       = new RHHashSlot<T>[slots];
+    sizeoftable = slots;
+    collisions  = 0;
+    for(ulong i = 0; i < count; i++)
+        if( old[i].obj ) place(old[i].obj, old[i].hash);
+
+    delete [] old;
+} // RHHashTable<T>::grow()
+
+
+// Function : void RHHashTable< T >::add_to_table(T *new_obj)
+// Purpose  : place a new object (class T) into the hash table
+// Note     : T must have method 'const char *key(void)', which will
+//            determine new_obj's position in the table
+//            the table is grown first if it would be over
+//            RHHASH_MAX_LOAD percent full
+// Warning  : -ONLY A POINTER IS BEING STORED IN THE TABLE-, as in
+//            HashTable::add_to_table()
+template < class T, class H >
+void RHHashTable< T, H >::add_to_table(T *new_obj)
+{
+    if( !sizeoftable )
+        init_hashtable(RHHASH_MIN_SIZE);
+    else if( (itemcount + 1) * 100 > sizeoftable * RHHASH_MAX_LOAD )
+        grow(sizeoftable * 2);
+
+    place(new_obj, getHashKey(new_obj->key()));
+    itemcount++;
+} // RHHashTable::add_to_table()
+
+
+// Function : long RHHashTable<T>::find(const char *x, uint hash) const
+// Purpose  : find the slot of the first value with key() == x, whose
+//            hash is hash, the probe stops at an empty slot, or at a
+//            value nearer its home than x would be, x can't be past it
+// Returns  : the slot, or -1 if none
+template <class T, class H> long RHHashTable<T, H>::find(const char *x, uint hash) const
+{
+    if( !sizeoftable ) return -1;
+
+    ulong pos = hash & mask();
+    for(ulong dist = 0; table[pos].obj && distance(pos) >= dist;
+        pos = (pos + 1) & mask(), dist++)
+        if( table[pos].hash == hash && keys.equal(table[pos].obj->key(), x) )
+            return pos;
+
+    return -1; // item was not in table
+} // RHHashTable<T>::find()
+
+
+// Function : long RHHashTable<T>::find(const T *x) const
+// Purpose  : find the slot pointing to x
+// Returns  : the slot, or -1 if none
+template <class T, class H> long RHHashTable<T, H>::find(const T *x) const
+{
+    if( !sizeoftable ) return -1;
+
+    uint  hash = getHashKey(x->key());
+    ulong pos  = hash & mask();
+    for(ulong dist = 0; table[pos].obj && distance(pos) >= dist;
+        pos = (pos + 1) & mask(), dist++)
+        if( table[pos].obj == x )
+            return pos;
+
+    return -1; // item was not in table
+} // RHHashTable<T>::find()
+
+
+// Function : void RHHashTable<T>::erase(ulong pos)
+// Purpose  : empty slot pos, and shift each following value that isn't
+//            in its home slot back one, up to an empty slot or a value
+//            that is home, so the table is as if pos never held a value
+template <class T, class H> void RHHashTable<T, H>::erase(ulong pos)
+{
+    if( distance(pos) ) collisions--;
+
+    for(ulong next = (pos + 1) & mask();
+        table[next].obj && distance(next);
+        pos = next, next = (next + 1) & mask())
+    {
+        table[pos] = table[next];
+        if( !distance(pos) ) collisions--;   // shifted back home
+    } // for
+
+    table[pos].obj  = 0;
+    table[pos].hash = 0;
+    itemcount--;
+} // RHHashTable<T>::erase()
+
+
+// Function : T *RHHashTable< T >::lookup(const char *x) const
+// Prupose  : to return a pointer to the object in the hash table with
+//            the key() == x
+// Return   : T * - if a object with key() == x was found
+//            0   - if no such object was found
+template <class T, class H> T *RHHashTable<T, H>::lookup(const char *x) const
+{
+    long pos = find(x, getHashKey(x));
+    if( pos < 0 ) return 0;
+    return table[pos].obj;
+} // RHHashTable<T>::lookup()
+
+
+// Function : bool RHHashTable< T >::remove(const T *x)
+// Prupose  : to remove the obj x from the hash table
+//            this is the same as remove_del(), except that
+//            remove() DOES NOT free x's memory (delete x)
+// Returns  : true  - 'x' found in table and removed
+//            false - 'x' not found in table
+template <class T, class H>
+  bool RHHashTable<T, H>::remove(const T *x)
+{
+    long pos = find(x);
+    if( pos < 0 ) return false;
+    erase(pos);
+    return true;
+}  // RHHashTable<T>::remove()
+
+
+// Function : bool RHHashTable< T >::remove_del(T *x)
+// Prupose  : to delete the T obj x, from the hash table
+//            AND - FREE IT'S MEMORY -
+// Returns  : true  - 'x' found in table and deleted
+//            false - 'x' not found in table and not deleted
+template <class T, class H>
+  bool RHHashTable<T, H>::remove_del(T *x)
+{
+    if( remove(x) )
+    {
+        delete x;
+        return true;
+    } // if
+
+    return false;
+}  // RHHashTable<T>::remove_del()
+
+
+// Function : T *RHHashTable< T >::remove(const char *x)
+// Prupose  : to remove the obj x from the hash table
+//            this is the same as remove_del(), except that
+//            remove() DOES NOT free x's memory (delete x)
+// Returns  : 0 - 'x' not found in table
+//            otherwise address of first T obj found in table
+//             with key() == x; that T obj removed from table
+template <class T, class H>
+  T *RHHashTable<T, H>::remove(const char *x)
+{
+    long pos = find(x, getHashKey(x));
+    if( pos < 0 ) return 0;
+    T *obj = table[pos].obj;  // save return value
+    erase(pos);
+    return obj;
+}  // RHHashTable<T>::remove()
+
+
+// Function : bool RHHashTable< T >::remove_del(const char *x)
+// Prupose  : to delete the T obj x, from the hash table
+//            AND - FREE IT'S MEMORY -
+// Returns  : true  - 'x' found in table and deleted
+//            false - 'x' not found in table
+template <class T, class H>
+  bool RHHashTable<T, H>::remove_del(const char *x)
+{
+    T *ptr = remove(x);
+    if( ptr )
+    {
+        delete ptr;
+        return true;
+    } // if
+
+    return false;
+}  // RHHashTable<T>::remove_del()
+
+
+} // namespace blib
+
+// rhhash.cxx
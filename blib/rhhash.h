@@ -0,0 +1,181 @@
+/*****************************************************************************/
+/*** Software: AMOS v0.01 (c)1998 All Rights Reserved by Bradley B. Custer ***/
+/*****************************************************************************/
+
+// File     : rhhash.h
+// Purpose  : define RHHashTable template class, an open addressing
+//            HashTable, with the same methods, whose values are kept
+//            in one array by Robin Hood hashing, so a lookup walks
+//            neighbouring slots, not a collision list
+// Contains : class RHHashTable, struct RHHashSlot, class rhhashit
+//
+// Update Log:
+//
+// 20261017 - Begun
+// 20261017 - keys are compared by a HashTable hash policy's equal(), RHHashTable<T, H>
+
+
+// prototypes
+namespace blib
+{
+template <class T> struct RHHashSlot;
+template <class T, class H> class RHHashTable;
+template <class T, class H> class rhhashit;
+} // namespace blib
+
+
+#ifndef RHHASH_CLASS_DEFINITION
+#define RHHASH_CLASS_DEFINITION
+
+
+#include <string>   // string class
+#include "blib.h"   // blib global prototypes, defines, etc
+
+
+using std::string;  // before hash.h, which uses it
+
+
+#include "hash.h"   // for the hash policies, hashdefault
+
+
+namespace blib
+{
+
+
+// the table is grown to twice its size when an add_to_table() would
+//  fill more than this percent of its slots, Robin Hood probes stay
+//  short up to about 90%
+#define  RHHASH_MAX_LOAD   90
+
+// fewest slots a table is given
+#define  RHHASH_MIN_SIZE   8
+
+
+// Struct  : struct RHHashSlot
+// Purpose : is an element of the RHHashTable array, obj points to the data
+// Note    : hash is the whole hash of obj->key(), its low bits are the
+//           slot obj belongs in, so how far obj is from there is known,
+//           and most keys that don't match are passed without a strcmp()
+template <class T> struct RHHashSlot
+{
+    T    *obj;    // pointer to data for this slot, 0 if empty
+    uint hash;    // hash of obj->key()
+
+    RHHashSlot(void) : obj(0), hash(0) {}
+}; // template struct RHHashSlot
+
+
+// Template: class RHHashTable
+// Purpose : open addressing hash table of T pointers, by Robin Hood
+//           hashing, a value that has come further from its home slot
+//           takes the slot of one that hasn't, and a removal shifts the
+//           following values back, so no slot is ever marked deleted
+// Note    : class T must have this method 'const char *key(void)'
+//           the table has a power of two slots, init_hashtable(size)
+//           rounds size up to one, and add_to_table() doubles the table
+//           when it would be more than RHHASH_MAX_LOAD percent full
+//           numberofcollisions() is the number of values not in their
+//           home slot
+//           H is a HashTable hash policy, hashdefault unless given, whose
+//           equal() compares keys, so the table is case sensitive or
+//           not as H is, the slots are hashed by getHashKey(), which
+//           folds case, and so serves either
+// Warning : remove() moves other values back a slot, so a rhhashit
+//           iterating the table may pass over a value, or meet it twice
+template <class T, class H = hashdefault> class RHHashTable
+{
+    protected:
+        // protected data -  accessable by derived classes
+        RHHashSlot<T> *table;        // the slots
+        ulong         sizeoftable;   // number of slots, a power of two or 0
+        ulong         itemcount;     // number of items in table
+        ulong         collisions;    // number of items not in their home slot
+        H             keys;          // compares keys, by keys.equal()
+
+        friend class rhhashit<T, H>;
+
+        ulong mask(void) const { return sizeoftable - 1; }
+        ulong distance(ulong pos) const        // slots table[pos] is past its home
+            { return (pos - (table[pos].hash & mask())) & mask(); }
+        void place(T *, uint);                 // put a value in the table, which has room
+        void grow(ulong);                      // move every value to a table of this many slots
+        long find(const char *, uint) const;   // slot of the first value with this key, -1 if none
+        long find(const T *) const;            // slot of this value, -1 if none
+        void erase(ulong);                     // empty a slot and shift the values after it back
+
+    public:
+        // constructors & desctructor
+        RHHashTable(void) : table(0), sizeoftable(0), itemcount(0), collisions(0), keys() {}
+        RHHashTable(ulong size, H h = H()) : table(0), sizeoftable(0), itemcount(0),
+            collisions(0), keys(h)
+            { init_hashtable(size); }
+        ~RHHashTable(void) { clr(); }
+
+        // mutators
+        void init_hashtable(ulong size);  // inits table to at least size slots, warning: clears any previous records
+        void add_to_table(T *);
+        void clr(void);        // Destroys all slots, RHHashTable zeroed
+        void free_all(void);   // same as clr() but also DELETES OBJECTS
+
+        bool remove(const T *);        // removes argument from hash table
+        bool remove_del(T *);          // same as remove() but also DELETES OBJECTS
+        T   *remove(const char *);
+        bool remove_del(const char *);
+
+        // inspectors
+        static uint getHashKey(const char *);  // the actual hash function, the whole hash, not a slot
+        static uint getHashKey(const string &x)
+            { return getHashKey( x.c_str() ); }
+
+        T *lookup(const char *) const;        // get pointer to objs with key() == x
+        T *lookup(const string &x) const
+            { return lookup( x.c_str() ); }
+
+        ulong size_of_table(void) const       // return the hash table size
+            { return sizeoftable; }
+        ulong numberofitems(void) const       // return the item counter
+            { return itemcount; }
+        ulong numberofcollisions(void) const  // return the collision counter
+            { return collisions; }
+}; // template class RHHashTable
+
+
+// Template : class rhhashit
+// Purpose  : const iterator class for RHHashTable, used just as chashit
+// Example  : for(rhhashit<obj> i(objtable); ++i;)
+//                i()->whatever();
+template <class T, class H = hashdefault> class rhhashit
+{
+    private:
+        T                    *ptr;       // pointer to current T obj
+        uint                 i;          // maintains iterative count
+        ulong                slot;       // next slot to look in
+        const RHHashTable<T, H> &table;  // table to iterate
+
+    public:
+        // constructor
+        rhhashit(const RHHashTable<T, H> &t) : table(t)
+          { start(); }
+
+        // mutators
+        void start(void)           // start iteration over again
+            { ptr = 0; i = 0; slot = 0; }
+        T *next(void);             // increment element being pointed to
+        T *operator++(void) { return next(); }
+
+        // inspectors
+        uint num(void) const       // return iteration position
+            { return i; }
+        T *operator()(void) const  // inspect value interator is pointing to
+            { return ptr; }
+}; // template class rhhashit
+
+
+} // namespace blib
+
+// need to include functions here, because this is a template class ADT
+#include "rhhash.cxx"
+
+#endif // RHHASH_CLASS_DEFINITION
+
+// rhhash.h
@@ -0,0 +1,586 @@
+/*****************************************************************************/
+/*** Software: AMOS v0.01 (c)1998 All Rights Reserved by Bradley B. Custer ***/
+/*****************************************************************************/
+
+// File    : skiplist.cxx
+// Purpose : contains template function members of skiplist class (skiplist.h)
+//
+// Update Log -
+//
+// 20261017 - Begun
+// 20261017 - added remove_node(), which skipit<T, LT>::remove() uses
+// 20261017 - add_copy() news its value nothrow, so a failed allocation returns 0
+
+
+// skip list class header
+#include "skiplist.h"
+
+#include <new>   // for std::nothrow
+
+
+namespace blib
+{
+
+
+// Template : skipnode<T> *skipnode<T>::make(T *v, uint levels)
+// Purpose  : allocate a node for value 'v', with room for its links
+//            on 'levels' levels after it, all unlinked
+// Returns  : the node, 0 if memory allocation failed
+template <class T>
+skipnode<T> *skipnode<T>::make(T *v, uint levels)
+{
+    void *m = ::operator new(sizeof(skipnode<T>) + (levels - 1) * sizeof(link), std::nothrow);
+    if( !m ) return 0;
+    skipnode<T> *n = (skipnode<T> *) m;
+    n->value  = v;
+    n->prior  = 0;
+    n->levels = levels;
+    for(uint k = 0; k < levels; k++)
+    {   n->links[k].next  = 0;
+        n->links[k].width = 0;
+    } // for
+    return n;
+}  // template skipnode<T>::make()
+
+
+// Template : skiplist<T, LT>::skiplist(LT less)
+// Purpose  : empty list ordered by 'less'
+template <class T, class LT>
+skiplist<T, LT>::skiplist(LT less)
+    : head(skipnode<T>::make(0, SKIPLIST_MAX_LEVEL)), tail(0),
+      length(0), level(1), seed(0x9E3779B9u), lt(less)
+{
+}  // template skiplist<T, LT>::skiplist()
+
+
+// Template : skiplist<T, LT>::skiplist(const skiplist<T, LT> &a)
+// Purpose  : copy of 'a', pointing to the same values, in the same order
+template <class T, class LT>
+skiplist<T, LT>::skiplist(const skiplist<T, LT> &a)
+    : head(skipnode<T>::make(0, SKIPLIST_MAX_LEVEL)), tail(0),
+      length(0), level(1), seed(0x9E3779B9u), lt(a.lt)
+{
+    operator=(a);
+}  // template skiplist<T, LT>::skiplist()
+
+
+// Template : skiplist<T, LT>::~skiplist()
+// Purpose  : free every node, does not delete the values pointed to
+template <class T, class LT>
+skiplist<T, LT>::~skiplist()
+{
+    purge();
+    skipnode<T>::unmake(head);
+}  // template skiplist<T, LT>::~skiplist()
+
+
+// Template : uint skiplist<T, LT>::new_level(void)
+// Purpose  : pick the number of levels of a new node, one more
+//            with probability 1/4 each time, from a xorshift
+//            generator of the list's own, so no shared state is used
+template <class T, class LT>
+uint skiplist<T, LT>::new_level(void)
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    uint lv = 1, bits = seed;
+    while( !(bits & 3) && lv < SKIPLIST_MAX_LEVEL )
+    {   lv++;
+        bits >>= 2;
+    } // while
+    return lv;
+}  // template skiplist<T, LT>::new_level()
+
+
+// Template : skipnode<T> *skiplist<T, LT>::find(T *v, bool after_equal,
+//                                              skipnode<T> **update, uint *pos) const
+// Purpose  : walk down from the top level to the last node less than
+//            'v', or, if after_equal, the last node not greater than 'v',
+//            noting on each level the last node walked to in update[]
+//            and its list position (head is 0, first node 1) in pos[]
+// Returns  : the level 0 node found, head if there is none
+// Note     : update and pos may each be 0 if not wanted
+template <class T, class LT>
+skipnode<T> *skiplist<T, LT>::find(T *v, bool after_equal,
+                                   skipnode<T> **update, uint *pos) const
+{
+    skipnode<T> *x = head;
+    uint at = 0;
+    for(uint k = level; k--;)
+    {
+        for(skipnode<T> *n = x->links[k].next; n; n = x->links[k].next)
+        {   if( after_equal ? lt(v, n->value) : !lt(n->value, v) ) break;
+            at += x->links[k].width;
+            x = n;
+        } // for
+        if( update ) update[k] = x;
+        if( pos ) pos[k] = at;
+    } // for
+    return x;
+}  // template skiplist<T, LT>::find()
+
+
+// Template : skipnode<T> *skiplist<T, LT>::find_num(uint i, skipnode<T> **update) const
+// Purpose  : walk down from the top level to the i-th node, by adding
+//            up link widths, noting on each level the last node before
+//            it in update[], if update isn't 0
+// Note     : i must be < length
+template <class T, class LT>
+skipnode<T> *skiplist<T, LT>::find_num(uint i, skipnode<T> **update) const
+{
+    skipnode<T> *x = head;
+    uint at = 0;   // list position of x, the i-th node is at i + 1
+    for(uint k = level; k--;)
+    {
+        while( x->links[k].next && at + x->links[k].width <= i )
+        {   at += x->links[k].width;
+            x = x->links[k].next;
+        } // while
+        if( update ) update[k] = x;
+    } // for
+    return x->links[0].next;
+}  // template skiplist<T, LT>::find_num()
+
+
+// Template : void skiplist<T, LT>::unlink(skipnode<T> *x, skipnode<T> **update, bool destroy)
+// Purpose  : unlink node 'x' from every level, update[k] being the last
+//            node before it on level k, and free it, deleting its value
+//            first if destroy, and drop levels left with no nodes
+template <class T, class LT>
+void skiplist<T, LT>::unlink(skipnode<T> *x, skipnode<T> **update, bool destroy)
+{
+    for(uint k = 0; k < level; k++)
+    {
+        if( update[k]->links[k].next == x )
+        {   update[k]->links[k].width += x->links[k].width - 1;
+            update[k]->links[k].next   = x->links[k].next;
+        } // if
+        else
+            update[k]->links[k].width--;
+    } // for
+    if( x->links[0].next ) x->links[0].next->prior = x->prior;
+    else tail = x->prior;
+    while( level > 1 && !head->links[level - 1].next )
+        head->links[--level].width = 0;
+    length--;
+    if( destroy ) delete x->value;
+    skipnode<T>::unmake(x);
+}  // template skiplist<T, LT>::unlink()
+
+
+// Template : bool skiplist<T, LT>::remove_num(uint i, bool destroy)
+// Purpose  : remove the i-th value, deleting it if destroy
+// Returns  : false if i is past the end of the list
+template <class T, class LT>
+bool skiplist<T, LT>::remove_num(uint i, bool destroy)
+{
+    if( i >= length ) return false;
+    skipnode<T> *update[SKIPLIST_MAX_LEVEL];
+    skipnode<T> *x = find_num(i, update);
+    unlink(x, update, destroy);
+    return true;
+}  // template skiplist<T, LT>::remove_num()
+
+
+// Template : uint skiplist<T, LT>::remove_node(skipnode<T> *x, bool destroy)
+// Purpose  : remove node 'x', deleting its value if destroy, finding
+//            the last node before it on each level by its value, and
+//            then walking the values equal to it, up to 'x' itself
+// Returns  : the list position 'x' had
+// Note     : unlike remove_num(), this doesn't need to know where 'x'
+//            is, so it can't be misled by values added before it
+template <class T, class LT>
+uint skiplist<T, LT>::remove_node(skipnode<T> *x, bool destroy)
+{
+    skipnode<T> *update[SKIPLIST_MAX_LEVEL];
+    uint pos[SKIPLIST_MAX_LEVEL];
+    skipnode<T> *n = find(x->value, false, update, pos);
+    uint i = pos[0];  // n's position counts head as 0, so this is the next node's
+    for(n = n->links[0].next; n != x; n = n->links[0].next, i++)
+        for(uint k = 0; k < n->levels; k++)  // an equal value before 'x'
+            update[k] = n;
+    unlink(x, update, destroy);
+    return i;
+}  // template skiplist<T, LT>::remove_node()
+
+
+// Template : uint skiplist<T, LT>::find_ptr(const T *v) const
+// Purpose  : find the list position of the node pointing to 'v', by
+//            finding the first value equal to *v and walking its equals
+// Returns  : the position, length if 'v' is not in the list
+template <class T, class LT>
+uint skiplist<T, LT>::find_ptr(const T *v) const
+{
+    if( !v || !length ) return length;
+    T *key = const_cast<T *>(v);
+    uint pos[SKIPLIST_MAX_LEVEL];
+    skipnode<T> *x = find(key, false, 0, pos)->links[0].next;
+    for(uint i = pos[0]; x && !lt(key, x->value); x = x->links[0].next, i++)
+        if( x->value == v ) return i;
+    return length;
+}  // template skiplist<T, LT>::find_ptr()
+
+
+// Template : skiplist<T, LT>::operator=(const skiplist<T, LT> &a)
+// Purpose  : copy skiplist; *this is purge()d and then given nodes
+//            pointing to 'a's values, in 'a's order, built at the
+//            end of the list, so in O(n) with no comparisons
+template <class T, class LT>
+void skiplist<T, LT>::operator=(const skiplist<T, LT> &a)
+{
+    if( &a == this ) return;
+    purge();
+    lt = a.lt;
+    skipnode<T> *last[SKIPLIST_MAX_LEVEL];   // last node on each level
+    uint         at[SKIPLIST_MAX_LEVEL];     // and its list position
+    for(uint k = 0; k < SKIPLIST_MAX_LEVEL; k++)
+    {   last[k] = head;
+        at[k]   = 0;
+    } // for
+    for(skipnode<T> *s = a.head->links[0].next; s; s = s->links[0].next)
+    {
+        uint lv = new_level();
+        skipnode<T> *n = skipnode<T>::make(s->value, lv);
+        if( !n ) break;  // memory allocation failed
+        length++;
+        for(uint k = 0; k < lv; k++)
+        {   last[k]->links[k].next  = n;
+            last[k]->links[k].width = length - at[k];
+            last[k] = n;
+            at[k]   = length;
+        } // for
+        n->prior = tail;
+        tail = n;
+        if( lv > level ) level = lv;
+    } // for
+    for(uint k = 0; k < level; k++)  // widths of the last links run to the end
+        last[k]->links[k].width = length - at[k];
+}  // template skiplist<T, LT>::operator=()
+
+
+// Template : skiplist<T, LT>::operator+=(const skiplist<T, LT> &a)
+// Purpose  : add 'a's value pointers to *this, each in order
+// Note     : *this += *this adds each value a second time
+template <class T, class LT>
+void skiplist<T, LT>::operator+=(const skiplist<T, LT> &a)
+{
+    if( &a == this )
+    {   skiplist<T, LT> again(a);
+        *this += again;
+        return;
+    } // if
+    for(skipnode<T> *s = a.head->links[0].next; s; s = s->links[0].next)
+        if( !add(s->value) ) return;  // memory allocation failed
+}  // template skiplist<T, LT>::operator+=()
+
+
+// Template : uint skiplist<T, LT>::add(T *newvalue)
+// Purpose  : add newvalue in order, after the values it equals
+// Returns  : 0 if newvalue is 0, or node allocation failed
+//            new legnth of list otherwise
+template <class T, class LT>
+uint skiplist<T, LT>::add(T *newvalue)
+{
+    if( !newvalue ) return 0;
+    skipnode<T> *update[SKIPLIST_MAX_LEVEL];
+    uint pos[SKIPLIST_MAX_LEVEL];
+    skipnode<T> *x = find(newvalue, true, update, pos);
+
+    uint lv = new_level();
+    skipnode<T> *n = skipnode<T>::make(newvalue, lv);
+    if( !n ) return 0;  // memory allocation failed
+    if( lv > level )
+    {   for(uint k = level; k < lv; k++)
+        {   update[k] = head;
+            pos[k]    = 0;
+            head->links[k].width = length;
+        } // for
+        level = lv;
+    } // if
+
+    // n goes in at position pos[0] + 1, each link into it
+    //  is split where it passes that position
+    for(uint k = 0; k < lv; k++)
+    {   n->links[k].next  = update[k]->links[k].next;
+        n->links[k].width = update[k]->links[k].width - (pos[0] - pos[k]);
+        update[k]->links[k].next  = n;
+        update[k]->links[k].width = pos[0] - pos[k] + 1;
+    } // for
+    for(uint k = lv; k < level; k++)  // the links over it are now a node longer
+        update[k]->links[k].width++;
+
+    n->prior = x == head ? 0 : x;
+    if( n->links[0].next ) n->links[0].next->prior = n;
+    else tail = n;
+    return ++length;
+}  // template skiplist<T, LT>::add()
+
+
+// Template : uint skiplist<T, LT>::add_copy(const T &newvalue)
+// Purpose  : add a new T, copied from newvalue with T::operator=()
+// Returns  : 0 if allocation failed
+//            new legnth of list otherwise
+template <class T, class LT>
+uint skiplist<T, LT>::add_copy(const T &newvalue)
+{
+    T *v = new (std::nothrow) T;
+    if( !v ) return 0;
+    *v = newvalue;
+    uint len = add(v);
+    if( !len ) delete v;
+    return len;
+}  // template skiplist<T, LT>::add_copy()
+
+
+// Template : bool skiplist<T, LT>::pop(void)
+// Purpose  : remove the first (least) value, does not delete it
+// Returns  : false if the list was empty
+template <class T, class LT>
+bool skiplist<T, LT>::pop(void)
+{
+    return remove_num(0, false);
+}  // template skiplist<T, LT>::pop()
+
+
+// Template : bool skiplist<T, LT>::pop_delete(void)
+// Purpose  : remove the first (least) value, and DELETE it
+// Returns  : false if the list was empty
+template <class T, class LT>
+bool skiplist<T, LT>::pop_delete(void)
+{
+    return remove_num(0, true);
+}  // template skiplist<T, LT>::pop_delete()
+
+
+// Template : bool skiplist<T, LT>::remove_last(void)
+// Purpose  : remove the last (greatest) value, does not delete it
+// Returns  : false if the list was empty
+template <class T, class LT>
+bool skiplist<T, LT>::remove_last(void)
+{
+    return length && remove_num(length - 1, false);
+}  // template skiplist<T, LT>::remove_last()
+
+
+// Template : bool skiplist<T, LT>::remove_last_delete(void)
+// Purpose  : remove the last (greatest) value, and DELETE it
+// Returns  : false if the list was empty
+template <class T, class LT>
+bool skiplist<T, LT>::remove_last_delete(void)
+{
+    return length && remove_num(length - 1, true);
+}  // template skiplist<T, LT>::remove_last_delete()
+
+
+// Template : bool skiplist<T, LT>::remove(const T *oldvalue)
+// Purpose  : removes oldvalue from list comparing pointer values,
+//            does not delete T object
+// Returns  : true -- oldvalue was found and removed from list
+//            false -- oldvalue was not found
+// Note     : O(log n), plus a step for each value equal to *oldvalue
+template <class T, class LT>
+bool skiplist<T, LT>::remove(const T *oldvalue)
+{
+    return remove_num(find_ptr(oldvalue), false);
+}  // template skiplist<T, LT>::remove()
+
+
+// Template : bool skiplist<T, LT>::remove_delete(T *oldvalue)
+// Purpose  : removes oldvalue from list comparing pointer values,
+//            and DELETES the T object
+// Returns  : true -- oldvalue was found and removed from list
+//            false -- oldvalue was not found
+template <class T, class LT>
+bool skiplist<T, LT>::remove_delete(T *oldvalue)
+{
+    return remove_num(find_ptr(oldvalue), true);
+}  // template skiplist<T, LT>::remove_delete()
+
+
+// Template : bool skiplist<T, LT>::remove(const T &oldvalue)
+// Purpose  : removes the first value neither less nor greater than
+//            oldvalue by LT, does not delete it
+// Returns  : true -- such a value was found and removed from list
+//            false -- there was none
+template <class T, class LT>
+bool skiplist<T, LT>::remove(const T &oldvalue)
+{
+    uint i = rank(oldvalue);
+    if( i >= length || lt(const_cast<T *>(&oldvalue), get_num(i)) ) return false;
+    return remove_num(i, false);
+}  // template skiplist<T, LT>::remove()
+
+
+// Template : bool skiplist<T, LT>::remove_delete(const T &oldvalue)
+// Purpose  : removes the first value neither less nor greater than
+//            oldvalue by LT, and DELETES it
+// Returns  : true -- such a value was found and removed from list
+//            false -- there was none
+// Note     : oldvalue must not be the value deleted
+template <class T, class LT>
+bool skiplist<T, LT>::remove_delete(const T &oldvalue)
+{
+    uint i = rank(oldvalue);
+    if( i >= length || lt(const_cast<T *>(&oldvalue), get_num(i)) ) return false;
+    return remove_num(i, true);
+}  // template skiplist<T, LT>::remove_delete()
+
+
+// Template : void skiplist<T, LT>::purge(void)
+// Purpose  : removes every value from the list
+//            but does NOT DELETE the values pointed to
+template <class T, class LT>
+void skiplist<T, LT>::purge(void)
+{
+    skipnode<T> *n = head->links[0].next, *next;
+    for(; n; n = next)
+    {   next = n->links[0].next;
+        skipnode<T>::unmake(n);
+    } // for
+    for(uint k = 0; k < SKIPLIST_MAX_LEVEL; k++)
+    {   head->links[k].next  = 0;
+        head->links[k].width = 0;
+    } // for
+    tail = 0;
+    length = 0;
+    level = 1;
+}  // template skiplist<T, LT>::purge()
+
+
+// Template : void skiplist<T, LT>::free_all(void)
+// Purpose  : deletes every value in the list, then purge()s it
+template <class T, class LT>
+void skiplist<T, LT>::free_all(void)
+{
+    for(skipnode<T> *n = head->links[0].next; n; n = n->links[0].next)
+        delete n->value;
+    purge();
+}  // template skiplist<T, LT>::free_all()
+
+
+// Template : bool skiplist<T, LT>::in_list(const T *a) const
+// Purpose  : report if pointer value 'a' is in the list, O(log n)
+template <class T, class LT>
+bool skiplist<T, LT>::in_list(const T *a) const
+{
+    return find_ptr(a) < length;
+}  // template skiplist<T, LT>::in_list()
+
+
+// Template : T *skiplist<T, LT>::ref_in_list(const T &a) const
+// Purpose  : return the first value equal to 'a' by T::operator==(),
+//            among those neither less nor greater than 'a' by LT
+// Returns  : 0 if there is none
+template <class T, class LT>
+T *skiplist<T, LT>::ref_in_list(const T &a) const
+{
+    T *key = const_cast<T *>(&a);
+    for(skipnode<T> *x = find(key, false, 0, 0)->links[0].next;
+        x && !lt(key, x->value); x = x->links[0].next)
+        if( *x->value == a ) return x->value;
+    return 0;
+}  // template skiplist<T, LT>::ref_in_list()
+
+
+// Template : T *skiplist<T, LT>::match_in_list(const string &key) const
+// Purpose  : return the first value for which T::matches(key) is true
+// Returns  : 0 if there is none
+// Note     : the key is not the order, so this walks the list
+template <class T, class LT>
+T *skiplist<T, LT>::match_in_list(const string &key) const
+{
+    for(skipnode<T> *x = head->links[0].next; x; x = x->links[0].next)
+        if( x->value->matches(key) ) return x->value;
+    return 0;
+}  // template skiplist<T, LT>::match_in_list()
+
+
+// Template : T *skiplist<T, LT>::lower_bound(const T &a) const
+// Purpose  : return the first value not less than 'a'
+// Returns  : 0 if every value is less than 'a'
+template <class T, class LT>
+T *skiplist<T, LT>::lower_bound(const T &a) const
+{
+    skipnode<T> *x = find(const_cast<T *>(&a), false, 0, 0)->links[0].next;
+    return x ? x->value : 0;
+}  // template skiplist<T, LT>::lower_bound()
+
+
+// Template : T *skiplist<T, LT>::upper_bound(const T &a) const
+// Purpose  : return the first value greater than 'a'
+// Returns  : 0 if no value is greater than 'a'
+template <class T, class LT>
+T *skiplist<T, LT>::upper_bound(const T &a) const
+{
+    skipnode<T> *x = find(const_cast<T *>(&a), true, 0, 0)->links[0].next;
+    return x ? x->value : 0;
+}  // template skiplist<T, LT>::upper_bound()
+
+
+// Template : uint skiplist<T, LT>::rank(const T &a) const
+// Purpose  : count the values less than 'a', which is the
+//            position of lower_bound(a), length if there is none
+template <class T, class LT>
+uint skiplist<T, LT>::rank(const T &a) const
+{
+    uint pos[SKIPLIST_MAX_LEVEL];
+    find(const_cast<T *>(&a), false, 0, pos);
+    return pos[0];
+}  // template skiplist<T, LT>::rank()
+
+
+// Template : T *skiplist<T, LT>::get_num(const uint i) const
+// Purpose  : return the i-th value, O(log n)
+// Returns  : 0 if i is past the end of the list
+template <class T, class LT>
+T *skiplist<T, LT>::get_num(const uint i) const
+{
+    if( i >= length ) return 0;
+    return find_num(i, 0)->value;
+}  // template skiplist<T, LT>::get_num()
+
+
+// Template : uint skipit<T, LT>::remove(void)
+// Purpose  : removes the value the iterator is pointing to,
+//            does NOT DELETE the T object, in O(log n)
+// Returns  : new legnth of list, 0 if list is (now) empty
+// Notes    : the iterator moves on to the next value, and
+//            step_made is handled as in dllit<T>::remove(), so
+//            a loop removing values should skip its ++ after
+//            a remove, as in
+//            for(skipit<T> i(list); !i.done();)
+//              if( -something- ) i.remove(); else ++i;
+template <class T, class LT>
+uint skipit<T, LT>::remove(void)
+{
+    if( !list.length || !ptr ) return 0;
+    bool resetting_head = at_start();
+    skipnode<T> *next = ptr->links[0].next;
+    i = list.remove_node(ptr, false);  // values added since may have moved it
+    if( !next ) { next = first(); i = 0; }  // was the last value, now pointing at head
+    ptr = next;
+    if( !resetting_head ) step_made = true;
+    return list.length;
+} // template skipit<T, LT>::remove()
+
+
+// Template : uint skipit<T, LT>::remove_delete(void)
+// Purpose  : removes the value the iterator is pointing to,
+//            and DELETES the T object
+// Returns  : new legnth of list, 0 if list is (now) empty
+// Notes    : same as remove()
+template <class T, class LT>
+uint skipit<T, LT>::remove_delete(void)
+{
+    if( !list.length || !ptr ) return 0;
+    T *old = ptr->value;
+    uint left = remove();
+    delete old;
+    return left;
+} // template skipit<T, LT>::remove_delete()
+
+
+} // namespace blib
+
+// skiplist.cxx
@@ -0,0 +1,293 @@
+/*****************************************************************************/
+/*** Software: AMOS v0.01 (c)1998 All Rights Reserved by Bradley B. Custer ***/
+/*****************************************************************************/
+
+// File    : skiplist.h
+// Purpose : contains templates for a sorted skip list ADT
+//           skiplist keeps T pointers in order, by the same less-thans
+//           dllist<T>::sort() takes, in a skip list of skipnode elements
+//           whose links count the nodes they skip, so that finding a
+//           value, or the i-th value, takes O(log n) steps
+//
+// Update Log -
+//
+// 20261017 - Begun, with the dllist methods and iterator protocol, lower_bound() and rank()
+// 20261017 - skipit<T, LT>::remove() removes its node by value, not by its position
+
+
+#ifndef SKIP_LIST_TEMPLATE
+#define SKIP_LIST_TEMPLATE
+
+
+#include <string>
+#include "blib.h"    // blib defines
+
+
+using std::string;
+
+
+namespace blib
+{
+
+
+// prototypes
+template <class T> struct skipnode;
+template <class T> struct skipless;
+template <class T> struct skipdll;
+template <class T, class LT = skipless<T> > class skiplist;
+template <class T, class LT = skipless<T> > class skipit;
+template <class T, class LT = skipless<T> > class cskipit;
+
+
+// most levels a skipnode can have, a node has k or more levels with
+//  probability 4^-(k-1), so 16 levels serve lists of 4^16 values
+#define  SKIPLIST_MAX_LEVEL  16
+
+
+// Template : struct skipless
+// Purpose  : the less-than of skiplist<T>, T::operator<(const T&),
+//            as dllist<T>::sort() uses
+template <class T> struct skipless
+{
+    bool operator()(T *a, T *b) const { return *a < *b; }
+}; // template struct skipless
+
+
+// Template : struct skipdll
+// Purpose  : the less-than of skiplist<T, skipdll<T> >,
+//            T::dll_lessthan(const T *), as dllist<T>::sort_dll() uses
+template <class T> struct skipdll
+{
+    bool operator()(T *a, T *b) const { return a->dll_lessthan(b); }
+}; // template struct skipdll
+
+
+// Template : struct skipnode
+// Purpose  : one value of a skiplist, with its link on each of its levels,
+//            links[k].width is the number of level 0 steps links[k] skips,
+//            links[] is as long as the node's level, allocated with it
+template <class T> struct skipnode
+{
+    struct link
+    {
+        skipnode<T> *next;
+        uint         width;
+    }; // struct link
+
+    T            *value;
+    skipnode<T>  *prior;     // prior node on level 0, 0 for the first
+    uint          levels;
+    link          links[1];  // links[0..levels-1]
+
+    static skipnode<T> *make(T *, uint);  // allocate a node with this many levels, 0 on failure
+    static void unmake(skipnode<T> *n)    // free a node, not its value
+        { ::operator delete(n); }
+}; // template struct skipnode
+
+
+// Template: class skiplist
+// Purpose : sorted container of T pointers, least first by the less-than
+//           LT, which is called as lt(T *a, T *b), true if a < b,
+//           skipless<T> (T::operator<()), skipdll<T> (T::dll_lessthan())
+//           or bool (*)(const T *, const T *), given to the constructor
+//           values that are neither less than the other are kept in
+//           the order they were added
+// Note    : add(), remove(), lower_bound(), upper_bound(), rank(),
+//           get_num() and the other positional methods are O(log n),
+//           iteration walks level 0, one step per value, just as dllist
+// Warning : just like dllist, the values pointed to are NOT DELETED
+//           when the list is purged, deleted, or a value removed,
+//           use free_all() or the *_delete() methods for that,
+//           and a value must not be changed, in a way that moves it
+//           in the order, while it is in the list, nor be 0
+template <class T, class LT> class skiplist
+{
+    private:
+        skipnode<T> *head;      // sentinel, with SKIPLIST_MAX_LEVEL levels
+        skipnode<T> *tail;      // last node, 0 if empty
+        uint length;            // length of list
+        uint level;             // levels in use, at least 1
+        uint seed;              // xorshift state for node levels
+        LT   lt;                // less-than
+
+        friend class skipit<T, LT>;
+        friend class cskipit<T, LT>;
+
+        uint new_level(void);                                   // random level for a new node
+        skipnode<T> *find(T *, bool, skipnode<T> **, uint *) const;  // last node less than v (or not greater), each level's and their positions
+        skipnode<T> *find_num(uint, skipnode<T> **) const;      // i-th node (i < length), and each level's last node before it
+        void unlink(skipnode<T> *, skipnode<T> **, bool);       // unlink and free a node, given its update nodes, deleting its value if asked
+        bool remove_num(uint, bool);                            // remove_num() and remove_num_delete()
+        uint remove_node(skipnode<T> *, bool);                  // remove a node found by its value, returns the position it had
+        uint find_ptr(const T *) const;                         // position of the node pointing to the value, length if none
+
+    public:
+        typedef cskipit<T, LT> citerator;   // const iterator type, for templates taking any blib list
+
+        // constructors
+        skiplist(LT less = LT());
+        skiplist(const skiplist<T, LT> &a);
+        // destructor
+        ~skiplist();  // this only frees the nodes, does not delete values pointed to
+
+        // mutators
+        void operator=(const skiplist<T, LT> &);  // assign *this to a copy of arguement's value pointers
+        void operator+=(const skiplist<T, LT> &); // add argument's value pointers to *this
+        uint add(T *);                        // adds value pointer in order, after any equal values, does NOT build a new T
+        uint add_copy(const T&);              // adds value pointer and builds a new T it points to, using T::operator=()
+        bool pop(void);                       // removes first (least) value, does not delete T objects
+        bool pop_delete(void);                // removes first (least) value, and DELETES T object it points to
+        bool remove(const T*);                // removes oldvalue from list comparing pointer values, does not delete T objects
+        bool remove_delete(T*);               // removes oldvalue from list comparing pointer values, DOES DELETE it
+        bool remove(const T&);                // removes first value equal by LT to oldvalue, does not delete it
+        bool remove_delete(const T&);         // removes first value equal by LT to oldvalue, DOES DELETE it
+        bool remove_last(void);               // removes last (greatest) value, does not delete T objects
+        bool remove_last_delete(void);        // removes last (greatest) value, and DELETES T object it points to
+        bool remove_num(uint i)               // removes i-th value, does not delete T objects
+            { return remove_num(i, false); }
+        bool remove_num_delete(uint i)        // removes i-th value, and DELETES T object it points to
+            { return remove_num(i, true); }
+        void purge(void);                     // removes every value from the list, does not delete T objects
+        void free_all(void);                  // deletes every value in the list, DELETES the T objects
+
+        // inspectors
+        bool in_list(const T*) const;              // report if argument is in list, comparing pointer values
+        T* ref_in_list(const T&) const;            // return 1st value equal to argument, by LT, then by T::operator==()
+        T* match_in_list(const string&) const;     // return 1st match to string key in list, comparing with "bool T::matches(const string&) const"
+        T* lower_bound(const T&) const;            // return 1st value not less than argument, 0 if none
+        T* upper_bound(const T&) const;            // return 1st value greater than argument, 0 if none
+        uint rank(const T&) const;                 // number of values less than argument, the position lower_bound() is at
+        T& operator[](uint i) const                // return reference to ith value
+            { return *get_num(i); }
+        T* get_num(const uint) const;              // return pointer to ith value, 0 if past end
+        T* first(void) const                       // return first (least) value
+            { if( length ) return head->links[0].next->value; else return 0; }
+        T* last(void) const                        // return last (greatest) value
+            { if( length ) return tail->value; else return 0; }
+        bool empty(void) const                     // report if list is empty
+            { if( length ) return false; else return true; }
+        uint size(void) const { return length; }    // report size of list
+}; // template class skiplist
+
+
+// Template : class skipit
+// Purpose  : iterator class for skiplist, used just as dllit
+//            for(skipit<T> i(list); !i.finished(); ++i) ;
+//            stepping past the last value goes round to the first
+// Note     : values can be removed through the iterator, but not
+//            assigned, that could take them out of order
+template <class T, class LT> class skipit
+{
+    private:
+        skipnode<T>         *ptr;       // node of current iteration
+        skiplist<T, LT>     &list;      // list being iterated
+        bool                step_made;  // flags whether iteration has begun
+        uint                i;          // maintains iterative position
+
+        skipnode<T> *first(void) const { return list.head->links[0].next; }
+
+    public:
+        // constructor
+        skipit(skiplist<T, LT> &L) : ptr(L.head->links[0].next), list(L), step_made(false), i(0) {}
+        skipit(skiplist<T, LT> &L, const uint &s)
+            : ptr(L.head->links[0].next), list(L), step_made(false), i(0)
+            { start_at(s); }
+
+        // mutators
+        void start(void)           // start iteration over again
+            { ptr = first(); step_made = false; i = 0; }
+        void start_at(const uint& s)  // same as start() then s ++'s, positions past the end wrap around, O(log n)
+            { start(); if( !list.length || !s ) return;
+              i = s % list.length; ptr = list.find_num(i, 0); step_made = true; }
+        T *operator++(void)        // increment element being pointed to
+            { step_made = true; if( !ptr ) return 0;
+              ptr = ptr->links[0].next; i++;
+              if( !ptr ) { ptr = first(); i = 0; }
+              return ptr->value; }
+        T *operator--(void)        // decrement element being pointed to
+            { step_made = true; if( !ptr ) return 0;
+              ptr = ptr->prior;
+              if( ptr ) i--; else { ptr = list.tail; i = list.length - 1; }
+              return ptr->value; }
+        uint remove(void);         // remove current iteration from list, does NOT DELETE value object
+        uint remove_delete(void);  // remove current iteration from list, WILL DELETE value object
+
+        // inspectors
+        uint num(void) const       // return iteration position
+            { return i; }
+        T *operator()(void) const  // inspect value interator is pointing to
+            { if( ptr ) return ptr->value; return 0; }
+        bool at_start(void) const  // is iterator pointing to first element?
+            { if( list.length ) return ptr == first(); return false; }
+        bool at_end(void) const    // is iterator pointing to last element?
+            { if( list.length ) return ptr == list.tail; return true; }
+        bool finished(void) const  // has a full list iteration occured ?
+            { if( list.length )
+              { if( step_made ) return at_start(); else return false; }
+              return true; }
+        bool done(void) const      // second name for finished()
+            { return finished(); }
+}; // template class skipit
+
+
+// Template : class cskipit
+// Purpose  : const iterator class for skiplist, used just as cdllit
+template <class T, class LT> class cskipit
+{
+    private:
+        const skipnode<T>       *ptr;       // node of current iteration
+        const skiplist<T, LT>   &list;      // list being iterated
+        bool                    step_made;  // flags whether iteration has begun
+        uint                    i;          // maintains iterative position
+
+        const skipnode<T> *first(void) const { return list.head->links[0].next; }
+
+    public:
+        // constructor
+        cskipit(const skiplist<T, LT> &L) : ptr(L.head->links[0].next), list(L), step_made(false), i(0) {}
+        cskipit(const skiplist<T, LT> &L, const uint &s)
+            : ptr(L.head->links[0].next), list(L), step_made(false), i(0)
+            { start_at(s); }
+
+        // mutators
+        void start(void)           // start iteration over again
+            { ptr = first(); step_made = false; i = 0; }
+        void start_at(const uint& s)  // same as start() then s ++'s, positions past the end wrap around, O(log n)
+            { start(); if( !list.length || !s ) return;
+              i = s % list.length; ptr = list.find_num(i, 0); step_made = true; }
+        T *operator++(void)        // increment element being pointed to
+            { step_made = true; if( !ptr ) return 0;
+              ptr = ptr->links[0].next; i++;
+              if( !ptr ) { ptr = first(); i = 0; }
+              return ptr->value; }
+        T *operator--(void)        // decrement element being pointed to
+            { step_made = true; if( !ptr ) return 0;
+              ptr = ptr->prior;
+              if( ptr ) i--; else { ptr = list.tail; i = list.length - 1; }
+              return ptr->value; }
+
+        // inspectors
+        uint num(void) const       // return iteration position
+            { return i; }
+        T *operator()(void) const  // inspect value interator is pointing to
+            { if( ptr ) return ptr->value; return 0; }
+        bool at_start(void) const  // is iterator pointing to first element?
+            { if( list.length ) return ptr == first(); return false; }
+        bool at_end(void) const    // is iterator pointing to last element?
+            { if( list.length ) return ptr == list.tail; return true; }
+        bool finished(void) const  // has a full list iteration occured ?
+            { if( list.length )
+              { if( step_made ) return at_start(); else return false; }
+              return true; }
+        bool done(void) const      // second name for finished()
+            { return finished(); }
+}; // template class cskipit
+
+
+} // namespace blib
+
+#include "skiplist.cxx"   // included b/c skiplist is a set of template classes, not compilable itself
+
+#endif // SKIP_LIST_TEMPLATE
+
+// skiplist.h
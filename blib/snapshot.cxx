@@ -0,0 +1,386 @@
+/*****************************************************************************/
+/*** Software: AMOS v0.01 (c)1998 All Rights Reserved by Bradley B. Custer ***/
+/*****************************************************************************/
+
+// File    : snapshot.cxx
+// Purpose : contains the methods of snapfile, and the snap_*() templates
+//
+// Update Log -
+//
+// 20261017 - Begun
+
+
+#include <cstring>        // for memcpy(), memcmp()
+#include <cerrno>         // for errno
+#include <stdio.h>        // for fopen(), fwrite(), fseek(), fclose()
+#include <fcntl.h>        // for open()
+#include <unistd.h>       // for close()
+#include <sys/mman.h>     // for mmap(), munmap()
+#include <sys/stat.h>     // for fstat()
+#include <vector>         // for the record buffer
+#include <type_traits>    // for std::is_trivially_copyable
+
+
+namespace blib
+{
+
+
+// Function : int snapfile::open(const char *name)
+// Purpose  : map the snapshot file name into memory, closing any
+//            file already open, and check that it is a whole snapshot
+// Returns  : 0     - successful, is_open()
+//            errno - the file couldn't be opened or mapped
+//            -1    - the file is not a snapshot, or is cut short
+inline int snapfile::open(const char *name)
+{
+    close();
+
+    int fd = ::open(name, O_RDONLY);
+    if( fd < 0 ) return errno;
+
+    struct stat st;
+    if( fstat(fd, &st) )
+    {
+        int err = errno;
+        ::close(fd);
+        return err;
+    } // if
+    if( (size_t) st.st_size < SNAPSHOT_HEADSIZE )
+    {
+        ::close(fd);
+        return -1;
+    } // if
+
+    // private, so the values can be written to without touching the file
+    void *m = mmap(0, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    int err = errno;
+    ::close(fd);                // the mapping keeps the file
+    if( m == MAP_FAILED ) return err;
+    map    = (char *) m;
+    length = st.st_size;
+
+    // check the header against the file
+    const snaphead *h = head();
+    bool good = !memcmp(h->magic, SNAPSHOT_MAGIC, sizeof(h->magic)) &&
+                h->order == 0x01020304 &&
+                h->datasize <= length - SNAPSHOT_HEADSIZE;
+    if( good && !(h->flags & SNAPSHOT_RECORDS) )
+        good = h->elemsize && h->count == h->datasize / h->elemsize;
+    if( !good )
+    {
+        close();
+        return -1;
+    } // if
+
+    return 0;
+} // snapfile::open()
+
+
+// Function : void snapfile::close(void)
+// Purpose  : unmap the file, if open
+inline void snapfile::close(void)
+{
+    if( map ) munmap(map, length);
+    map    = 0;
+    length = 0;
+} // snapfile::close()
+
+
+// Template : struct snapraw
+// Purpose  : the serializer of a trivially copyable T, its bytes,
+//            written without a record header
+template <class T> struct snapraw
+{
+    uint size(const T &) const { return sizeof(T); }
+    void write(const T &v, char *p) const { memcpy(p, &v, sizeof(T)); }
+}; // template struct snapraw
+
+
+// Template : struct snapwriter
+// Purpose  : writes each value it is called with to a snapshot file,
+//            as a record if records, or just its bytes
+template <class T, class S> struct snapwriter
+{
+    FILE              *file;
+    const S           &ser;
+    bool              records;
+    std::vector<char> buf;      // one value, or record, at a time
+    uint64_t          count;
+    uint64_t          bytes;
+    bool              failed;
+
+    snapwriter(FILE *f, const S &s, bool r)
+        : file(f), ser(s), records(r), count(0), bytes(0), failed(false) {}
+
+    void operator()(const T *v)
+    {
+        if( !v || failed ) return;   // 0 values aren't saved
+        uint n = ser.size(*v);
+        size_t head = records ? 8 : 0;
+        size_t rec  = records ? (head + n + 7) & ~(size_t) 7 : n;
+        buf.assign(rec, 0);
+        if( records )
+        {
+            uint32_t len = n;
+            memcpy(&buf[0], &len, sizeof(len));
+        } // if
+        ser.write(*v, &buf[head]);
+        if( fwrite(&buf[0], 1, rec, file) != rec ) failed = true;
+        count++;
+        bytes += rec;
+    } // operator()()
+}; // template struct snapwriter
+
+
+// Template : snap_walk()
+// Purpose  : call w(value) for each value of a dllist or HashTable
+template <class T, class W> inline void snap_walk(const dllist<T> &list, W &w)
+{
+    for(cdllit<T> i(list); !i.finished(); ++i)
+        w(i());
+} // template snap_walk()
+
+template <class T, class H, class W> inline void snap_walk(const HashTable<T, H> &table, W &w)
+{
+    if( table.size_of_table() )  // chashit needs a table
+        for(chashit<T, H> i(table); ++i;)
+            w(i());
+} // template snap_walk()
+
+
+// Template : snap_add()
+// Purpose  : add a loaded value to a dllist or HashTable
+template <class T> inline void snap_add(dllist<T> &list, T *v)
+    { list.add(v); }
+template <class T, class H> inline void snap_add(HashTable<T, H> &table, T *v)
+    { table.add_to_table(v); }
+
+
+// Template : int snap_write(const C &c, const char *name, uint kind,
+//                           uint64_t tablesize, const S &ser, bool records)
+// Purpose  : write the snapshot file name of the list or table c,
+//            writing each value with the serializer ser
+// Returns  : 0     - successful
+//            errno - the file couldn't be opened or written
+template <class T, class C, class S>
+  int snap_write(const C &c, const char *name, uint kind, uint64_t tablesize,
+                 const S &ser, bool records)
+{
+    FILE *file = fopen(name, "wb");
+    if( !file ) return errno;
+
+    // the header is written last, once the values are counted
+    char head[SNAPSHOT_HEADSIZE] = { 0 };
+    bool good = fwrite(head, 1, sizeof(head), file) == sizeof(head);
+
+    snapwriter<T, S> w(file, ser, records);
+    if( good ) snap_walk(c, w);
+    good = good && !w.failed;
+
+    snaphead h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, SNAPSHOT_MAGIC, sizeof(h.magic));
+    h.order     = 0x01020304;
+    h.kind      = kind;
+    h.flags     = records ? SNAPSHOT_RECORDS : 0;
+    h.elemsize  = records ? 0 : sizeof(T);
+    h.count     = w.count;
+    h.tablesize = tablesize;
+    h.datasize  = w.bytes;
+    memcpy(head, &h, sizeof(h));
+    good = good && !fseek(file, 0, SEEK_SET) &&
+           fwrite(head, 1, sizeof(head), file) == sizeof(head);
+
+    int err = good ? 0 : (errno ? errno : -1);
+    if( fclose(file) && !err ) err = errno ? errno : -1;
+    return err;
+} // template snap_write()
+
+
+// Template : bool snap_fill(C &c, const snapfile &file, uint kind, bool copy)
+// Purpose  : add each value of the snapshot file of T's to the list
+//            or table c, new copies of the values if copy, otherwise
+//            the values in the mapping
+// Returns  : true  - successful
+//            false - the file isn't a snapshot of this kind and T
+template <class T, class C>
+  bool snap_fill(C &c, const snapfile &file, uint kind, bool copy)
+{
+    const snaphead *h = file.head();
+    if( !file.holds(kind, sizeof(T)) || (h->flags & SNAPSHOT_RECORDS) )
+        return false;
+
+    // the values are T's, one after another, aligned in the mapping
+    char *p = file.data();
+    for(uint64_t i = 0; i < h->count; i++, p += sizeof(T))
+        snap_add(c, copy ? new T(*(const T *) p) : (T *) p);
+
+    return true;
+} // template snap_fill()
+
+
+// Template : bool snap_records(C &c, const snapfile &file, uint kind, const S &ser)
+// Purpose  : add the T read by the serializer ser from each record of
+//            the snapshot file to the list or table c
+// Returns  : true  - successful
+//            false - the file isn't a snapshot of this kind, or a
+//                    record is cut short or couldn't be read, the values
+//                    before it have been added
+template <class T, class C, class S>
+  bool snap_records(C &c, const snapfile &file, uint kind, const S &ser)
+{
+    const snaphead *h = file.head();
+    if( !file.holds(kind, 0) || !(h->flags & SNAPSHOT_RECORDS) )
+        return false;
+
+    const char *p   = file.data();
+    const char *end = p + h->datasize;
+    for(uint64_t i = 0; i < h->count; i++)
+    {
+        uint32_t len;
+        if( end - p < 8 ) return false;
+        memcpy(&len, p, sizeof(len));
+        if( (uint64_t) len > (uint64_t) (end - p - 8) ) return false;
+        T *v = ser.read(p + 8, len);
+        if( !v ) return false;
+        snap_add(c, v);
+        p += (8 + (size_t) len + 7) & ~(size_t) 7;
+    } // for
+
+    return true;
+} // template snap_records()
+
+
+// Template : int snap_save(const dllist<T> &list, const char *name)
+// Purpose  : write the snapshot file name of list's values, T must be
+//            trivially copyable, its bytes are saved
+// Returns  : 0     - successful
+//            errno - the file couldn't be opened or written
+template <class T> int snap_save(const dllist<T> &list, const char *name)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "snap_save() without a serializer needs a trivially copyable T");
+    static_assert(alignof(T) <= SNAPSHOT_HEADSIZE, "T is too aligned for a snapshot");
+    return snap_write<T>(list, name, SNAPSHOT_DLLIST, 0, snapraw<T>(), false);
+} // template snap_save()
+
+
+// Template : int snap_save(const dllist<T> &list, const char *name, S ser)
+// Purpose  : write the snapshot file name of list's values, each a
+//            record written by the serializer ser
+template <class T, class S> int snap_save(const dllist<T> &list, const char *name, S ser)
+{
+    return snap_write<T>(list, name, SNAPSHOT_DLLIST, 0, ser, true);
+} // template snap_save()
+
+
+// Template : int snap_save(const HashTable<T> &table, const char *name)
+// Purpose  : write the snapshot file name of table's values and its
+//            table size, T must be trivially copyable
+template <class T, class H> int snap_save(const HashTable<T, H> &table, const char *name)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "snap_save() without a serializer needs a trivially copyable T");
+    static_assert(alignof(T) <= SNAPSHOT_HEADSIZE, "T is too aligned for a snapshot");
+    return snap_write<T>(table, name, SNAPSHOT_HASH, table.size_of_table(), snapraw<T>(), false);
+} // template snap_save()
+
+
+// Template : int snap_save(const HashTable<T> &table, const char *name, S ser)
+// Purpose  : write the snapshot file name of table's values and its
+//            table size, each value a record written by the serializer ser
+template <class T, class H, class S> int snap_save(const HashTable<T, H> &table, const char *name, S ser)
+{
+    return snap_write<T>(table, name, SNAPSHOT_HASH, table.size_of_table(), ser, true);
+} // template snap_save()
+
+
+// Template : bool snap_load(dllist<T> &list, const snapfile &file)
+// Purpose  : add a new T copy of each value of a dllist snapshot to list,
+//            the copies are the list's, as if add_copy()'d, and the
+//            file can be closed afterward
+// Returns  : true  - successful
+//            false - file is not a dllist snapshot of T's
+template <class T> bool snap_load(dllist<T> &list, const snapfile &file)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "snap_load() without a serializer needs a trivially copyable T");
+    return snap_fill<T>(list, file, SNAPSHOT_DLLIST, true);
+} // template snap_load()
+
+
+// Template : bool snap_load(dllist<T> &list, const snapfile &file, S ser)
+// Purpose  : add the T read by the serializer ser from each record of
+//            a dllist snapshot to list
+// Returns  : true  - successful
+//            false - file is not a dllist snapshot of records, or a record
+//                    couldn't be read, the values before it were added
+template <class T, class S> bool snap_load(dllist<T> &list, const snapfile &file, S ser)
+{
+    return snap_records<T>(list, file, SNAPSHOT_DLLIST, ser);
+} // template snap_load()
+
+
+// Template : bool snap_map(dllist<T> &list, const snapfile &file)
+// Purpose  : add each value of a dllist snapshot to list, pointing
+//            at the value in the mapping, so nothing is copied
+// Returns  : true  - successful
+//            false - file is not a dllist snapshot of T's
+// Warning  : see class snapfile, file must outlive list and the values
+//            must not be deleted
+template <class T> bool snap_map(dllist<T> &list, const snapfile &file)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "snap_map() needs a trivially copyable T");
+    return snap_fill<T>(list, file, SNAPSHOT_DLLIST, false);
+} // template snap_map()
+
+
+// Template : bool snap_load(HashTable<T> &table, const snapfile &file)
+// Purpose  : init_hashtable() table to the saved table size, and add
+//            a new T copy of each value of a HashTable snapshot to it
+// Returns  : true  - successful
+//            false - file is not a HashTable snapshot of T's, table is unchanged
+// Warning  : like init_hashtable(), any values already in table are
+//            dropped from it, but not deleted
+template <class T, class H> bool snap_load(HashTable<T, H> &table, const snapfile &file)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "snap_load() without a serializer needs a trivially copyable T");
+    if( !file.holds(SNAPSHOT_HASH, sizeof(T)) ) return false;
+    table.init_hashtable(file.head()->tablesize);
+    return snap_fill<T>(table, file, SNAPSHOT_HASH, true);
+} // template snap_load()
+
+
+// Template : bool snap_load(HashTable<T> &table, const snapfile &file, S ser)
+// Purpose  : init_hashtable() table to the saved table size, and add
+//            the T read by the serializer ser from each record of a
+//            HashTable snapshot to it
+// Returns  : true  - successful
+//            false - file is not a HashTable snapshot of records, table
+//                    is unchanged, or a record couldn't be read, the
+//                    values before it were added
+template <class T, class H, class S> bool snap_load(HashTable<T, H> &table, const snapfile &file, S ser)
+{
+    if( !file.holds(SNAPSHOT_HASH, 0) ) return false;
+    table.init_hashtable(file.head()->tablesize);
+    return snap_records<T>(table, file, SNAPSHOT_HASH, ser);
+} // template snap_load()
+
+
+// Template : bool snap_map(HashTable<T> &table, const snapfile &file)
+// Purpose  : init_hashtable() table to the saved table size, and add
+//            each value of a HashTable snapshot to it, pointing at the
+//            value in the mapping, so nothing is copied
+// Returns  : true  - successful
+//            false - file is not a HashTable snapshot of T's, table is unchanged
+// Warning  : see class snapfile, file must outlive table and the values
+//            must not be deleted
+template <class T, class H> bool snap_map(HashTable<T, H> &table, const snapfile &file)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "snap_map() needs a trivially copyable T");
+    if( !file.holds(SNAPSHOT_HASH, sizeof(T)) ) return false;
+    table.init_hashtable(file.head()->tablesize);
+    return snap_fill<T>(table, file, SNAPSHOT_HASH, false);
+} // template snap_map()
+
+
+} // namespace blib
+
+// snapshot.cxx
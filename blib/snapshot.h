@@ -0,0 +1,147 @@
+/*****************************************************************************/
+/*** Software: AMOS v0.01 (c)1998 All Rights Reserved by Bradley B. Custer ***/
+/*****************************************************************************/
+
+// File    : snapshot.h
+// Purpose : contains the binary snapshot file of a dllist or HashTable,
+//           snap_save() writes the values of a list or table to a file,
+//           and snapfile maps such a file into memory, from which
+//           snap_load() builds the list or table again, with no parsing,
+//           or snap_map() builds it pointing at the values in the mapping
+//
+// Update Log -
+//
+// 20261017 - Begun
+// 20261017 - the HashTable templates take a table of any hash policy, HashTable<T, H>
+
+
+// prototypes
+namespace blib
+{
+struct snaphead;
+class  snapfile;
+} // namespace blib
+
+
+#ifndef SNAPSHOT_TEMPLATE
+#define SNAPSHOT_TEMPLATE
+
+
+#include <stdint.h>     // for uint32_t, uint64_t
+#include <stddef.h>     // for size_t
+#include "blib.h"       // blib defines
+#include "dll.h"        // for dllist
+#include "hash.h"       // for HashTable
+
+
+namespace blib
+{
+
+
+// a snapshot file starts with this, the last byte is the format version
+#define  SNAPSHOT_MAGIC    "BLIBSNP1"
+
+// the bytes a snaphead takes in the file, the values follow it,
+//  so values of any alignment up to this are aligned in the mapping
+#define  SNAPSHOT_HEADSIZE  64
+
+// snaphead::kind, what the snapshot was saved from
+#define  SNAPSHOT_DLLIST   1
+#define  SNAPSHOT_HASH     2
+
+// snaphead::flags
+#define  SNAPSHOT_RECORDS  1    // values were written by a serializer, as records
+
+
+// Struct  : struct snaphead
+// Purpose : the first SNAPSHOT_HEADSIZE bytes of a snapshot file
+// Note    : values are written in the byte order of the machine that
+//           saved them, order is 0x01020304 written in that order, so a
+//           snapshot from a machine of another byte order isn't loaded
+//           when flags has SNAPSHOT_RECORDS each value is a record,
+//           a uint32_t byte count then the bytes the serializer wrote,
+//           padded to 8 bytes, otherwise each is a T of elemsize bytes
+struct snaphead
+{
+    char      magic[8];     // SNAPSHOT_MAGIC
+    uint32_t  order;        // 0x01020304, for the byte order
+    uint32_t  kind;         // SNAPSHOT_DLLIST or SNAPSHOT_HASH
+    uint32_t  flags;        // SNAPSHOT_RECORDS, or 0
+    uint32_t  elemsize;     // sizeof(T), 0 for records
+    uint64_t  count;        // number of values
+    uint64_t  tablesize;    // HashTable::size_of_table(), 0 for a dllist
+    uint64_t  datasize;     // bytes of values after the header
+}; // struct snaphead
+
+
+// Class   : class snapfile
+// Purpose : a snapshot file mapped into memory, read only on disk,
+//           copy on write in memory, by mmap(), until close()d
+// Note    : open() checks the header and size of the file, so a
+//           snapfile that is_open() has all the values its header says
+// Warning : values snap_map() has pointed a list or table at are in the
+//           mapping, so the snapfile must outlive the list or table,
+//           and the values must not be deleted, free_all() must not be
+//           used on the list or table
+class snapfile
+{
+    private:
+        char    *map;       // the mapping, 0 if not open
+        size_t  length;     // bytes mapped
+
+        snapfile(const snapfile &);          // not copyable, it owns the mapping
+        void operator=(const snapfile &);
+
+    public:
+        // constructors
+        snapfile(void) : map(0), length(0) {}
+        snapfile(const char *name) : map(0), length(0) { open(name); }
+        // destructor
+        ~snapfile(void) { close(); }
+
+        // mutators
+        int open(const char *);     // map a snapshot file, 0 on success, errno or -1 if not a snapshot
+        void close(void);           // unmap the file
+
+        // inspectors
+        bool is_open(void) const { return map != 0; }
+        const snaphead *head(void) const       // the header, 0 if not open
+            { return (const snaphead *) map; }
+        char *data(void) const                 // the first value, 0 if not open
+            { if( map ) return map + SNAPSHOT_HEADSIZE; return 0; }
+        bool holds(uint kind, uint elemsize) const  // is open, a snapshot of this kind and value size
+            { return map && head()->kind == kind && head()->elemsize == elemsize; }
+}; // class snapfile
+
+
+// Serializers : snap_save(), snap_load() given a serializer S take
+//            values of T that are not trivially copyable, S has
+//              uint size(const T &) const           bytes the value's record needs
+//              void write(const T &, char *) const  write the record, of size() bytes
+//              T   *read(const char *, uint) const  new T built from a record of so many bytes
+//            the bytes of a record are aligned to 8
+
+// saving, 0 on success, errno on a failed write
+template <class T> int snap_save(const dllist<T> &, const char *);                // T trivially copyable
+template <class T, class S> int snap_save(const dllist<T> &, const char *, S);    // T written by S
+template <class T, class H> int snap_save(const HashTable<T, H> &, const char *);
+template <class T, class H, class S> int snap_save(const HashTable<T, H> &, const char *, S);
+
+// loading, values are added to the list or table, a table is first
+//  init_hashtable()'d to the saved table size, false if the snapshot
+//  is not of this kind of container and value
+template <class T> bool snap_load(dllist<T> &, const snapfile &);             // new T copies of the values
+template <class T, class S> bool snap_load(dllist<T> &, const snapfile &, S); // new T read by S
+template <class T> bool snap_map(dllist<T> &, const snapfile &);              // pointers into the mapping, no copies
+template <class T, class H> bool snap_load(HashTable<T, H> &, const snapfile &);
+template <class T, class H, class S> bool snap_load(HashTable<T, H> &, const snapfile &, S);
+template <class T, class H> bool snap_map(HashTable<T, H> &, const snapfile &);
+
+
+} // namespace blib
+
+#include "snapshot.cxx"   // included b/c snap_*() are templates, not compilable themselves
+
+#endif // SNAPSHOT_TEMPLATE
+
+// snapshot.h
@@ -5,6 +5,9 @@
 // Update Log -
 //
 // 20120409 - Begun
+// 20261017 - ...Stats iterate with their list type's citerator
+// 20261017 - the sqrt<>() specializations call std::sqrt(), not themselves, and the definitions of
+//            random_walk_null_step_prob_to_hit_by() and make_jump_walks_that_hit_a_or_b_by_t() match stats.h
 
 
 namespace blib
@@ -17,13 +20,13 @@ namespace blib
 
 // type specific math functions
 template<class U> inline U sqrt(const U x) { return sqrt<U>(x); }
-template<> inline int         sqrt<int        >(const int         x) { return int  (sqrt(double(x))); }
-template<> inline uint        sqrt<uint       >(const uint        x) { return uint (sqrt(double(x))); }
-template<> inline long        sqrt<long       >(const long        x) { return long (sqrt(double(x))); }
-template<> inline ulong       sqrt<ulong      >(const ulong       x) { return ulong(sqrt(double(x))); }
-template<> inline float       sqrt<float      >(const float       x) { return sqrt(x); }
-template<> inline double      sqrt<double     >(const double      x) { return sqrt(x); }
-template<> inline long double sqrt<long double>(const long double x) { return sqrt(x); }
+template<> inline int         sqrt<int        >(const int         x) { return int  (std::sqrt(double(x))); }
+template<> inline uint        sqrt<uint       >(const uint        x) { return uint (std::sqrt(double(x))); }
+template<> inline long        sqrt<long       >(const long        x) { return long (std::sqrt(double(x))); }
+template<> inline ulong       sqrt<ulong      >(const ulong       x) { return ulong(std::sqrt(double(x))); }
+template<> inline float       sqrt<float      >(const float       x) { return std::sqrt(x); }
+template<> inline double      sqrt<double     >(const double      x) { return std::sqrt(x); }
+template<> inline long double sqrt<long double>(const long double x) { return std::sqrt(x); }
 
 template<class U> inline bool isnan(const U x) { return isnan<U>(x); }
 template<> inline bool isnan<float      >(const float       x) { return std::isnan(x); }
@@ -38,8 +41,8 @@ template<> inline bool isnormal<long double>(const long double x) { return std::
 
 // calculate ave & ave^2 for x-axis, must be done before calc_stats_*(),
 // done at construction if list.size() > 0
-template<class U>
-void OneVarStats<U>::calc_x_stats(void)
+template<class U, class L>
+void OneVarStats<U,L>::calc_x_stats(void)
 {
   if( list.empty() ) return;
   // test if *this constructed to default to compute sub-list stats
@@ -73,11 +76,11 @@ void OneVarStats<U>::calc_x_stats(void)
     ave_x    /= list.size();
     ave_x_sq /= list.size();
   } // else
-} // OneVarStats<U>::calc_x_stats()
+} // OneVarStats<U,L>::calc_x_stats()
 
 // calculate least squares linear regression and stddev
-template<class U>
-void OneVarStats<U>::calc_stats_all(void)
+template<class U, class L>
+void OneVarStats<U,L>::calc_stats_all(void)
 {
   if( list.empty() ) return;
 
@@ -85,7 +88,7 @@ void OneVarStats<U>::calc_stats_all(void)
     ave_y    = 0;  // average y (the actual data values)
   U ave_y_sq = 0;  // average y squared
   U ave_xy   = 0;  // average of x*y
-  for(cdllit<U> i(list); !i.done(); ++i)
+  for(typename L::citerator i(list); !i.done(); ++i)
   {
     ave_y    += *i();
     ave_y_sq += (*i())*(*i());
@@ -105,7 +108,7 @@ void OneVarStats<U>::calc_stats_all(void)
     reg_err    = 0;  // regression error (average absolute distance from the regression line)
   U ave_err_sq = 0;  // average error squared (for error's std dev)
   U tmp        = 0;  // used for computing error
-  for(cdllit<U> i(list); !i.done(); ++i)
+  for(typename L::citerator i(list); !i.done(); ++i)
   {
     tmp         = *i() - slp*(i.num()+1) - icpt;
     reg_err    += abs_val(tmp);
@@ -116,11 +119,11 @@ void OneVarStats<U>::calc_stats_all(void)
   ave_err_sq /= list.size();
   // standard deviation in the distance from the regression line
   reg_err_stdev = sqrt<U>(ave_err_sq - reg_err*reg_err);
-} // OneVarStats<U>::calc_stats_all()
+} // OneVarStats<U,L>::calc_stats_all()
 
 // calculate on subset of list, given start & end nodes
-template<class U>
-void OneVarStats<U>::calc_stats_sub(const uint s, const uint e)
+template<class U, class L>
+void OneVarStats<U,L>::calc_stats_sub(const uint s, const uint e)
 { // s is the start position, e is s+num-to-iterate, ie. 0-starting end position
   if( list.empty()        ||
       s > list.size() - 1 ||
@@ -131,7 +134,7 @@ void OneVarStats<U>::calc_stats_sub(const uint s, const uint e)
     ave_y    = 0;  // average y (the actual data values)
   U ave_y_sq = 0;  // average y squared
   U ave_xy   = 0;  // average of x*y
-  cdllit<U> i(list);
+  typename L::citerator i(list);
   i.start_at(s);
   do
   {
@@ -168,12 +171,12 @@ void OneVarStats<U>::calc_stats_sub(const uint s, const uint e)
   ave_err_sq /= size;
   // standard deviation in the distance from the regression line
   reg_err_stdev = sqrt<U>(ave_err_sq - reg_err*reg_err);
-} // OneVarStats<U>::calc_stats_sub()
+} // OneVarStats<U,L>::calc_stats_sub()
 
 
 // calculate least squares linear regression and stddev
-template<class T, class U>
-void TwoVarStats<T,U>::calc_stats_all(void)
+template<class T, class U, class L>
+void TwoVarStats<T,U,L>::calc_stats_all(void)
 {
   if( list.empty() ) return;
 
@@ -187,7 +190,7 @@ void TwoVarStats<T,U>::calc_stats_all(void)
   lowest_x  = list.first()->x();
   highest_y = list.first()->y();
   lowest_y  = list.first()->y();
-  for(cdllit<T> i(list); !i.done(); ++i)
+  for(typename L::citerator i(list); !i.done(); ++i)
   {
     ave_x += i()->x();
     ave_y += i()->y();
@@ -204,7 +207,7 @@ void TwoVarStats<T,U>::calc_stats_all(void)
   U var_x = 0;
   U var_y = 0;
   covar   = 0;
-  for(cdllit<T> i(list); !i.done(); ++i)
+  for(typename L::citerator i(list); !i.done(); ++i)
   {
     var_x += (i()->x() - ave_x)*(i()->x() - ave_x);
     var_y += (i()->y() - ave_y)*(i()->y() - ave_y);
@@ -226,7 +229,7 @@ void TwoVarStats<T,U>::calc_stats_all(void)
     reg_err    = 0;  // regression error (average absolute distance from the regression line)
   U ave_err_sq = 0;  // average error squared (for error's std dev)
   U tmp        = 0;  // used for computing error
-  for(cdllit<T> i(list); !i.done(); ++i)
+  for(typename L::citerator i(list); !i.done(); ++i)
   {
     tmp         = i()->y() - slp*(i()->x()) - icpt;
     reg_err    += abs_val(tmp);
@@ -237,12 +240,12 @@ void TwoVarStats<T,U>::calc_stats_all(void)
   ave_err_sq /= Bessel_corr_size;
   // standard deviation in the distance from the regression line  (not worrying about another loop for variance on reg err)
   reg_err_stdev = sqrt<U>(ave_err_sq - reg_err*reg_err);
-} // TwoVarStats<T,U>::calc_stats_all()
+} // TwoVarStats<T,U,L>::calc_stats_all()
 
 
 // calculate on subset of list, given start & end nodes
-template<class T, class U>
-void TwoVarStats<T,U>::calc_stats_sub(const uint s, const uint e)
+template<class T, class U, class L>
+void TwoVarStats<T,U,L>::calc_stats_sub(const uint s, const uint e)
 { // s is the start position, e is s+num-to-iterate, ie. 0-starting end position
   if( list.empty()        ||
       s > list.size() - 1 ||
@@ -255,7 +258,7 @@ void TwoVarStats<T,U>::calc_stats_sub(const uint s, const uint e)
   // do one loop through the data values & compute counts
   ave_x = 0;  // average x (the actual data values)
   ave_y = 0;  // average y (the actual data values)
-  cdllit<T> i(list);
+  typename L::citerator i(list);
   i.start_at(s);
   highest_x = i()->x();
   lowest_x  = i()->x();
@@ -318,7 +321,7 @@ void TwoVarStats<T,U>::calc_stats_sub(const uint s, const uint e)
   ave_err_sq /= Bessel_corr_size;
   // standard deviation in the distance from the regression line
   reg_err_stdev = sqrt<U>(ave_err_sq - reg_err*reg_err);
-} // TwoVarStats<T,U>::calc_stats_sub()
+} // TwoVarStats<T,U,L>::calc_stats_sub()
 
 
 // rounds up to 1st whole number, if x>0     (ex. 1.45 -> 2)
@@ -749,7 +752,7 @@ U ProbabilityDistributions<U>::random_walk_null_step_CDF
 // that reached x.
 template<class U>
 U ProbabilityDistributions<U>::random_walk_null_step_prob_to_hit_by
-(const uint& n, const int& a, const U& p_1, const U& p_2)
+(const uint n, const int a, const U p_1, const U p_2)
 {
   // nonsense input
   if( n < 1 ) return 0;
@@ -1118,7 +1121,7 @@ U ProbabilityDistributions<U>::random_walk_prob_to_a_before_b_by
 //          false - recursion limit was reached
 template<class U>
 bool ProbabilityDistributions<U>::make_jump_walks_that_hit_a_or_b_by_t
-(const int a, const int b, const int t, const int num_types, const int* step_types, dllist<jump_walk_struct>& walks)
+(const int& a, const int& b, const int& t, const int& num_types, const int* step_types, dllist<jump_walk_struct>& walks)
 {
   // test for walk termination states
   if( a <= 0 )  // a > 0 unless stepped past threshold
@@ -5,6 +5,9 @@
 // Update Log -
 //
 // 20120409 - Begun
+// 20261017 - OneVarStats and TwoVarStats take the list type as a template argument, dllist by default,
+//            so a udllist (or any list with a citerator type) can be given
+// 20261017 - std::vector in jump_walk_struct, so stats.h compiles
 
 
 #ifndef BLIB_STATS_DEFINED
@@ -15,6 +18,7 @@
 #include  <vector>   // used by jump_walk_struct
 #include  "blib.h"
 #include  "dll.h"
+#include  "udll.h"
 
 
 namespace blib
@@ -56,10 +60,12 @@ template<class U> class Pt2Var
     bool matches(const U& a) { return X == a; }
 }; // Pt2Var<U>
 
-template<class U> class OneVarStats
+// the list type L must have size(), empty() and a citerator type,
+//  as dllist<U> and udllist<U> do
+template<class U, class L = dllist<U> > class OneVarStats
 {
   private:
-    const dllist<U>&  list;   // data points
+    const L&          list;   // data points
     uint              start;  // 0-starting position in list to start stats at
     uint              end;    // 0-starting +1 position in list to end stats at (ie. will loop with condition while(i < end))
 
@@ -74,7 +80,7 @@ template<class U> class OneVarStats
     U  reg_err_stdev;
  
   public:
-    OneVarStats<U>(const dllist<U>& l, const uint s = 0, const uint e = 0)
+    OneVarStats<U,L>(const L& l, const uint s = 0, const uint e = 0)
       : list(l), start(s), end(e),
         ave_y(0), ave_x(0), ave_x_sq(0), stdev_y(0), slp(0), icpt(0),
         reg_err(0), reg_err_stdev(0)
@@ -98,12 +104,12 @@ template<class U> class OneVarStats
     U intercept(void) const { return icpt; }   // regression line intercept
     U regression_error(void) const { return reg_err; }  // average absolute distance from regression line
     U regression_error_stddev(void) const { return reg_err_stdev; }  // std dev of the distance from the regression line
-}; // OneVarStats<U>
+}; // OneVarStats<U,L>
 
-template<class T, class U> class TwoVarStats
+template<class T, class U, class L = dllist<T> > class TwoVarStats
 {
   private:
-    const dllist<T>&  list;   // data points
+    const L&          list;   // data points
     uint              start;  // 0-starting position in list to start stats at
     uint              end;    // 0-starting +1 position in list to end stats at (ie. will loop with condition while(i < end))
 
@@ -125,7 +131,7 @@ template<class T, class U> class TwoVarStats
     U  reg_err_stdev;
  
   public:
-    TwoVarStats<T,U>(const dllist<T>& l, const uint s = 0, const uint e = 0)
+    TwoVarStats<T,U,L>(const L& l, const uint s = 0, const uint e = 0)
       : list(l), start(s), end(e), size(0),
         ave_y(0), ave_x(0), stdev_y(0), stdev_x(0),
         highest_x(0), lowest_x(0), highest_y(0), lowest_y(0),
@@ -161,13 +167,13 @@ template<class T, class U> class TwoVarStats
     U intercept(void) const { return icpt; }   // linear regression line intercept
     U regression_error(void) const { return reg_err; }  // average absolute distance from regression line  (ave sqr of dist from reg line is same as var of y-dist of pts from reg line, this is the # minimized by reg line)
     U regression_error_stddev(void) const { return reg_err_stdev; }  // std dev of the distance from the regression line
-}; // TwoVarStats<T,U>
+}; // TwoVarStats<T,U,L>
 
 // for use in ProbabilityDistributions::make_jump_walks_that_hit_a_or_b_by_t()
 struct jump_walk_struct
 {
   int result;  // 0 - result was not determined, 1 - reached a before b, 2 - reached b before a, 3 - walk did not reach a or b within t steps
-  vector<int> steps;
+  std::vector<int> steps;
 
   jump_walk_struct(void) : result(0) {}
 
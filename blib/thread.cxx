@@ -4,6 +4,7 @@
 // Update Log -
 //
 // 20100802 - Begun
+// 20261017 - added Thread::Thread(void*(*)(void*), void*)
 
 
 #include  <iostream>      // for debugging
@@ -39,6 +40,23 @@ Thread::Thread(void*(*EntryPoint)(void*))
 } // Thread::Thread()
 
 
+// Function : Thread::Thread(void*(*)(void*), void*)
+// Purpose  : Creates a pthread, represented by *this,
+//            which starts at EntryPoint(arg), for workers
+//            that need their own data rather than *this.
+Thread::Thread(void*(*EntryPoint)(void*), void* arg)
+{
+    dead = false;
+
+    errcode = pthread_create(&thread,    //  pthread struct
+                             NULL,       //  default thread attributes
+                             EntryPoint, //  execution start point
+                             arg);       //  the entry point's argument
+
+    if( errcode ) dead = true;  // mark the thread still-born
+} // Thread::Thread(void*(*)(void*), void*)
+
+
 // Function : Thread::~Thread()
 // Purpose  : Kill *this thread.
 //            The descructor should never be called except by the
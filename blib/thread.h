@@ -5,6 +5,7 @@
 //
 // Update Log -
 // 20100802 - Began Thread user interface class
+// 20261017 - added Thread(void*(*)(void*), void*), to hand the thread its own argument
 
 
 // prototypes
@@ -86,6 +87,7 @@ class Thread
 
         // constructor & destructor
         Thread(void*(*)(void*));          // thread created here, pthread_create()
+        Thread(void*(*)(void*), void*);   // same, but the entry point gets the 2nd argument rather than this
         virtual ~Thread(void);  // thread resources deallocated here, pthread_join()
 
         // mutators
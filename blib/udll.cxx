@@ -0,0 +1,764 @@
+/*****************************************************************************/
+/*** Software: AMOS v0.01 (c)1998 All Rights Reserved by Bradley B. Custer ***/
+/*****************************************************************************/
+
+// File    : udll.cxx
+// Purpose : contains template function members of udllist class (udll.h)
+//
+// Update Log -
+//
+// 20261017 - Begun
+
+
+// unrolled doublely-linked list class header
+#include "udll.h"
+
+#include <new>        // for std::nothrow
+#include <cstring>    // for memcpy(), memmove()
+#include <algorithm>  // for std::stable_sort()
+
+
+namespace blib
+{
+
+
+// Template : udllchunk<T> *udllist<T>::locate(uint i, uint &offset) const
+// Purpose  : find the chunk holding the i-th value, walking chunk
+//            by chunk from whichever of the head, the last chunk or
+//            the cursor is nearest, the found chunk becomes the cursor
+// Note     : const, the cursor is a dllcursor, so threads reading the
+//            list at once each take it whole, or not at all
+// Returns  : the chunk, and the value's position in it in 'offset'
+// Note     : i must be < length
+template <class T>
+udllchunk<T> *udllist<T>::locate(uint i, uint &offset) const
+{
+    udllchunk<T> *c = head;
+    uint pos = 0;                         // list position of c->value[0]
+    uint dist = i;
+
+    uint tail_pos = length - head->prior->count;
+    if( (i >= tail_pos ? i - tail_pos : tail_pos - i) < dist )
+    {   c    = head->prior;
+        pos  = tail_pos;
+        dist = i >= pos ? i - pos : pos - i;
+    } // if
+    udllchunk<T> *cc;
+    uint          cpos;
+    if( cursor.get(cc, cpos) && (i >= cpos ? i - cpos : cpos - i) < dist )
+    {   c   = cc;
+        pos = cpos;
+    } // if
+
+    while( i >= pos + c->count )
+    {   pos += c->count;
+        c    = c->next;
+    } // while
+    while( i < pos )
+    {   c    = c->prior;
+        pos -= c->count;
+    } // while
+
+    cursor.set(c, pos);
+    offset = i - pos;
+    return c;
+} // template udllist<T>::locate()
+
+
+// Template : udllchunk<T> *udllist<T>::new_chunk_after(udllchunk<T> *c)
+// Purpose  : link a new, empty chunk into the ring after 'c',
+//            if 'c' is 0 the new chunk becomes the whole ring
+// Returns  : the new chunk, 0 if allocation failed
+template <class T>
+udllchunk<T> *udllist<T>::new_chunk_after(udllchunk<T> *c)
+{
+    udllchunk<T> *n = new (std::nothrow) udllchunk<T>;
+    if( !n ) return 0;  // memory allocation failed
+    if( !c )
+    {   n->next = n->prior = n;
+        head = n;
+        return n;
+    } // if
+    n->prior       = c;
+    n->next        = c->next;
+    c->next->prior = n;
+    c->next        = n;
+    return n;
+} // template udllist<T>::new_chunk_after()
+
+
+// Template : void udllist<T>::free_chunk(udllchunk<T> *c)
+// Purpose  : unlink chunk 'c' from the ring and delete it,
+//            its values must already be gone or moved
+template <class T>
+void udllist<T>::free_chunk(udllchunk<T> *c)
+{
+    if( cursor.at() == c ) cursor.clear();
+    if( c->next == c ) head = 0;
+    else
+    {   c->prior->next = c->next;
+        c->next->prior = c->prior;
+        if( head == c ) head = c->next;
+    } // else
+    delete c;
+} // template udllist<T>::free_chunk()
+
+
+// Template : void udllist<T>::insert_at(udllchunk<T> *c, uint offset, T *a)
+// Purpose  : put 'a' at c->value[offset], moving later values of 'c' down,
+//            a full chunk is split in two first, except when adding on
+//            the end of the list or the front of the head chunk, which
+//            starts a new chunk so add()s and push()es leave chunks full
+// Returns  : 0 if allocation failed for a new chunk
+//            new legnth of list otherwise
+// Note     : the cursor stays good when it is 'c'
+template <class T>
+uint udllist<T>::insert_at(udllchunk<T> *c, uint offset, T *a)
+{
+    if( cursor.at() != c ) cursor.clear();  // chunks after 'c' are about to move down
+    if( c->count == UDLL_CHUNK_SIZE )
+    {
+        if( offset == UDLL_CHUNK_SIZE && c == head->prior )
+        {   // appending, start a new last chunk
+            if( !(c = new_chunk_after(c)) ) return 0;
+            offset = 0;
+        } // if
+        else if( !offset && c == head )
+        {   // pushing, start a new head chunk
+            if( !(c = new_chunk_after(head->prior)) ) return 0;
+            head   = c;
+            cursor.clear();
+        } // else if
+        else
+        {   // split 'c', its last half moves to a new chunk
+            udllchunk<T> *n = new_chunk_after(c);
+            if( !n ) return 0;
+            const uint half = UDLL_CHUNK_SIZE / 2;
+            memcpy(n->value, c->value + half, (UDLL_CHUNK_SIZE - half) * sizeof(T *));
+            n->count = UDLL_CHUNK_SIZE - half;
+            c->count = half;
+            if( offset > half )
+            {   c       = n;
+                offset -= half;
+            } // if
+        } // else
+    } // if
+
+    memmove(c->value + offset + 1, c->value + offset, (c->count - offset) * sizeof(T *));
+    c->value[offset] = a;
+    c->count++;
+    return ++length;
+} // template udllist<T>::insert_at()
+
+
+// Template : T *udllist<T>::remove_at(udllchunk<T> *c, uint offset)
+// Purpose  : take c->value[offset] out of the list, an emptied chunk
+//            is freed, and a chunk left a quarter full or less is
+//            merged with a neighbor when their values fit in one chunk
+// Returns  : the value removed
+// Note     : the cursor stays good when it is 'c' and 'c' survives
+template <class T>
+T *udllist<T>::remove_at(udllchunk<T> *c, uint offset)
+{
+    if( cursor.at() != c ) cursor.clear();  // chunks after 'c' are about to move up
+    T *value = c->value[offset];
+    memmove(c->value + offset, c->value + offset + 1, (c->count - offset - 1) * sizeof(T *));
+    c->count--;
+    length--;
+
+    if( !c->count ) free_chunk(c);
+    else if( c->count <= UDLL_CHUNK_SIZE / 4 )
+    {
+        udllchunk<T> *n = c->next;
+        udllchunk<T> *p = c->prior;
+        if( n != head && c->count + n->count <= UDLL_CHUNK_SIZE )
+        {   // pull the next chunk's values up into 'c'
+            memcpy(c->value + c->count, n->value, n->count * sizeof(T *));
+            c->count += n->count;
+            free_chunk(n);
+        } // if
+        else if( c != head && p->count + c->count <= UDLL_CHUNK_SIZE )
+        {   // push the values of 'c' onto the end of the prior chunk
+            memcpy(p->value + p->count, c->value, c->count * sizeof(T *));
+            p->count += c->count;
+            free_chunk(c);
+        } // else if
+    } // else if
+    return value;
+} // template udllist<T>::remove_at()
+
+
+// Template : void udllist<T>::purge(void)
+// Purpose  : removes every value from the list, freeing the chunks
+//            does NOT DELETE the T objects pointed to
+template <class T> void udllist<T>::purge(void)
+{
+    if( head )
+    {   head->prior->next = 0;  // open the ring
+        while( head )
+        {   udllchunk<T> *tmp = head;
+            head = head->next;
+            delete tmp;
+        } // while
+    } // if
+    length = 0;
+    cursor.clear();
+}  // template udllist<T>::purge()
+
+
+// Template : void udllist<T>::free_all(void)
+// Purpose  : removes every value from the list
+//            and DELETES the T objects pointed to
+template <class T> void udllist<T>::free_all(void)
+{
+    if( length )
+    {   udllchunk<T> *c = head;
+        do
+        {   for(uint j = 0; j < c->count; j++)
+                delete c->value[j];
+            c = c->next;
+        } while( c != head );
+    } // if
+    purge();
+}  // template udllist<T>::free_all()
+
+
+// Template : udllist<T>::operator=(const udllist<T> &a)
+// Purpose  : copy udllist; *this is purge()d and then
+//            turned into a duplicate copy of 'a',
+//            pointers are copied NOT instances
+template <class T>
+void udllist<T>::operator=(const udllist<T> &a)
+{
+    if( &a == this ) return;
+    if( length ) purge();  // clear out current chunks
+    *this += a;
+}  // template udllist<T>::operator=()
+
+
+// Template : udllist<T>::operator+=(const udllist<T> &a)
+// Purpose  : add argument's value pointers to end of *this,
+//            copying a chunk at a time
+// Note     : *this += *this doubles the list
+template <class T>
+void udllist<T>::operator+=(const udllist<T> &a)
+{
+    if( !a.length ) return;
+    const udllchunk<T> *c   = a.head;
+    const udllchunk<T> *end = a.head->prior;  // fixed now, in case &a == this
+    for(;;)
+    {
+        udllchunk<T> *n = new_chunk_after(head ? head->prior : 0);
+        if( !n ) return;  // memory allocation failed
+        memcpy(n->value, c->value, c->count * sizeof(T *));
+        n->count  = c->count;
+        length   += c->count;
+        if( c == end ) break;
+        c = c->next;
+    } // for
+}  // template udllist<T>::operator+=()
+
+
+// Template : udllist<T>::copy(const udllist<T> &a)
+// Purpose  : copy udllist; *this is purge()d and then
+//            turned into a list with values pointing to
+//            duplicates of the values 'a' points to,
+//            T::operator=() is used to COPY INSTANCES
+template <class T> void udllist<T>::copy(const udllist<T> &a)
+{
+    if( &a == this ) return;
+    if( length ) purge();  // clear out current chunks
+    for(cudllit<T> i(a); !i.finished(); ++i)
+        if( !add_copy(*i()) ) return;
+}  // template udllist<T>::copy()
+
+
+// Template : void udllist<T>::append_and_purge(udllist<T> &a)
+// Purpose  : splices the chunks of 'a' onto the end of *this in O(1),
+//            leaving 'a' purge()d
+template <class T>
+void udllist<T>::append_and_purge(udllist<T> &a)
+{
+    if( !a.length || &a == this ) return;
+    if( !length ) head = a.head;
+    else
+    {   udllchunk<T> *last   = head->prior;
+        udllchunk<T> *a_last = a.head->prior;
+        last->next    = a.head;
+        a.head->prior = last;
+        a_last->next  = head;
+        head->prior   = a_last;
+    } // else
+    length  += a.length;
+    a.head   = 0;
+    a.length = 0;
+    a.cursor.clear();
+}  // template udllist<T>::append_and_purge()
+
+
+// Template : uint udllist<T>::add(T *newvalue)
+// Purpose  : add newvalue at the end of the list
+//            does NOT build a new copy of T
+// Returns  : 0 if allocation failed for a new chunk
+//            new legnth of list otherwise
+template <class T> uint udllist<T>::add(T *newvalue)
+{
+    if( !length && !new_chunk_after(0) ) return 0;
+    return insert_at(head->prior, head->prior->count, newvalue);
+}  // template udllist<T>::add()
+
+
+// Template : uint udllist<T>::add_copy(const T& newvalue)
+// Purpose  : add a value at the end of the list pointing to
+//            a new T, which gets its value from T::operator=()
+// Returns  : 0 if allocation failed
+//            new legnth of list otherwise
+template <class T> uint udllist<T>::add_copy(const T& newvalue)
+{
+    T *tmp = new (std::nothrow) T;
+    if( !tmp ) return 0;  // memory allocation failed
+    *tmp = newvalue;
+    uint l = add(tmp);
+    if( !l ) delete tmp;
+    return l;
+}  // template udllist<T>::add_copy()
+
+
+// Template : uint udllist<T>::push(T *newvalue)
+// Purpose  : add newvalue at the beginning of the list
+// Returns  : 0 if allocation failed for a new chunk
+//            new legnth of list otherwise
+template <class T> uint udllist<T>::push(T *newvalue)
+{
+    if( !length ) return add(newvalue);
+    return insert_at(head, 0, newvalue);
+}  // template udllist<T>::push()
+
+
+// Template : uint udllist<T>::add_num(T *newvalue, uint num)
+// Purpose  : add newvalue at the num-th position of the list
+//            the old num-th value moves down one position
+//            'num' is taken to be zero starting
+// Returns  : 0 if allocation failed for a new chunk
+//            new legnth of list otherwise
+// Note     : if num >= length, newvalue becomes the end
+template <class T>
+uint udllist<T>::add_num(T *newvalue, uint num)
+{
+    if( num >= length ) return add(newvalue);
+    uint offset;
+    udllchunk<T> *c = locate(num, offset);
+    return insert_at(c, offset, newvalue);
+}  // template udllist<T>::add_num()
+
+
+// Template : bool udllist<T>::pop(void)
+// Purpose  : remove the head of the list
+//            does NOT DELETE the T object pointed to
+// Returns  : TRUE if successful, and head removed
+//            FALSE if there was nothing in the list
+template <class T> bool udllist<T>::pop(void)
+{
+    if( !length ) return false;
+    remove_at(head, 0);
+    return true;
+}  // template udllist<T>::pop()
+
+
+// Template : bool udllist<T>::pop_delete(void)
+// Purpose  : remove the head of the list
+//            and DELETES the T objected pointed to
+// Returns  : TRUE if successful, and head removed
+//            FALSE if there was nothing in the list
+template <class T> bool udllist<T>::pop_delete(void)
+{
+    if( !length ) return false;
+    delete remove_at(head, 0);
+    return true;
+}  // template udllist<T>::pop_delete()
+
+
+// Template : bool udllist<T>::remove(const T *oldvalue)
+// Purpose  : removes first value equal to the pointer 'oldvalue'
+//            does NOT DELETE the T object pointed to
+// Returns  : FALSE if 'oldvalue' wasn't found
+//            TRUE otherwise
+template <class T>
+bool udllist<T>::remove(const T *oldvalue)
+{
+    if( !length ) return false;
+    udllchunk<T> *c = head;
+    do
+    {   for(uint j = 0; j < c->count; j++)
+            if( c->value[j] == oldvalue )
+            {   remove_at(c, j);
+                return true;
+            } // if
+        c = c->next;
+    } while( c != head );
+    return false;  // 'oldvalue' wasn't found
+}  // template udllist<T>::remove()
+
+
+// Template : bool udllist<T>::remove_delete(T *oldvalue)
+// Purpose  : removes first value equal to the pointer 'oldvalue'
+//            and DELETES the T object pointed to
+// Returns  : FALSE if 'oldvalue' wasn't found
+//            TRUE otherwise
+template <class T>
+bool udllist<T>::remove_delete(T *oldvalue)
+{
+    if( !remove((const T *)oldvalue) ) return false;
+    delete oldvalue;
+    return true;
+}  // template udllist<T>::remove_delete()
+
+
+// Template : bool udllist<T>::remove(const T& oldvalue)
+// Purpose  : removes first value equal to 'oldvalue', comparing
+//            with T::operator==(), does NOT DELETE the T object
+// Returns  : FALSE if no value equal to 'oldvalue' was found
+//            TRUE otherwise
+template <class T>
+bool udllist<T>::remove(const T& oldvalue)
+{
+    T *found = ref_in_list(oldvalue);
+    if( !found ) return false;
+    return remove((const T *)found);
+}  // template udllist<T>::remove()
+
+
+// Template : bool udllist<T>::remove_delete(const T& oldvalue)
+// Purpose  : removes first value equal to 'oldvalue', comparing
+//            with T::operator==(), and DELETES the T object
+// Returns  : FALSE if no value equal to 'oldvalue' was found
+//            TRUE otherwise
+template <class T>
+bool udllist<T>::remove_delete(const T& oldvalue)
+{
+    T *found = ref_in_list(oldvalue);
+    if( !found ) return false;
+    return remove_delete(found);
+}  // template udllist<T>::remove_delete()
+
+
+// Template : bool udllist<T>::remove_last(void)
+// Purpose  : remove the end of the list
+//            does NOT DELETE the T object pointed to
+// Returns  : TRUE if successful, and last removed
+//            FALSE if there was nothing in the list
+template <class T> bool udllist<T>::remove_last(void)
+{
+    if( !length ) return false;
+    remove_at(head->prior, head->prior->count - 1);
+    return true;
+}  // template udllist<T>::remove_last()
+
+
+// Template : bool udllist<T>::remove_last_delete(void)
+// Purpose  : remove the end of the list
+//            and DELETES the T objected pointed to
+// Returns  : TRUE if successful, and last removed
+//            FALSE if there was nothing in the list
+template <class T> bool udllist<T>::remove_last_delete(void)
+{
+    if( !length ) return false;
+    delete remove_at(head->prior, head->prior->count - 1);
+    return true;
+}  // template udllist<T>::remove_last_delete()
+
+
+// Template : bool udllist<T>::remove_num(uint num)
+// Purpose  : removes num-th value, num is zero starting
+//            does NOT DELETE the T object pointed to
+// Returns  : FALSE if num >= length
+//            TRUE otherwise
+template <class T>
+bool udllist<T>::remove_num(uint num)
+{
+    if( num >= length ) return false;
+    uint offset;
+    udllchunk<T> *c = locate(num, offset);
+    remove_at(c, offset);
+    return true;
+}  // template udllist<T>::remove_num()
+
+
+// Template : bool udllist<T>::remove_num_delete(uint num)
+// Purpose  : removes num-th value, num is zero starting
+//            and DELETES the T objected pointed to
+// Returns  : FALSE if num >= length
+//            TRUE otherwise
+template <class T>
+bool udllist<T>::remove_num_delete(uint num)
+{
+    if( num >= length ) return false;
+    uint offset;
+    udllchunk<T> *c = locate(num, offset);
+    delete remove_at(c, offset);
+    return true;
+}  // template udllist<T>::remove_num_delete()
+
+
+// Template : uint udllist<T>::sort(void)
+// Purpose  : sorts the list greatest-to-least comparing
+//            values with T::operator<()
+// Returns  : number of comparisons performed for sort
+// Note     : a 0 value is treated as least in list, see array_sort()
+template <class T> uint udllist<T>::sort(void)
+{
+    return array_sort( [](T *a, T *b)
+                       { if( !a || !b ) return !a && b; return *a < *b; } );
+} // template udllist<T>::sort()
+
+
+// Template : uint udllist<T>::sort_dll(void)
+// Purpose  : sorts the list greatest-to-least comparing
+//            values with T::dll_lessthan(const T *)
+// Returns  : number of comparisons performed for sort
+// Note     : a 0 value is treated as least in list, see array_sort()
+template <class T> uint udllist<T>::sort_dll(void)
+{
+    return array_sort( [](T *a, T *b)
+                       { if( !a || !b ) return !a && b; return a->dll_lessthan(b); } );
+} // template udllist<T>::sort_dll()
+
+
+// Template : uint udllist<T>::sort(bool (*)())
+// Purpose  : sorts the list greatest-to-least comparing
+//            values with the function 'lt'
+// Returns  : number of comparisons performed for sort
+// Note     : a 0 value is treated as least in list, see array_sort()
+template <class T>
+uint udllist<T>::sort(bool (*lt)(const T *, const T *))
+{
+    return array_sort( [lt](T *a, T *b)
+                       { if( !a || !b ) return !a && b; return (*lt)(a, b); } );
+} // template udllist<T>::sort(bool (*))
+
+
+// Template : uint udllist<T>::array_sort(LT lt)
+// Purpose  : stable sort of the list greatest-to-least, 'lt(a,b)' must
+//            return true if value 'a' is less than value 'b'
+//            the values are gathered into one array, which is sorted
+//            with std::stable_sort() and written back into the same
+//            chunks, so no chunk is allocated or freed
+// Returns  : number of comparisons performed for sort
+//            0 if the array could not be allocated, list left unsorted
+template <class T> template <class LT>
+uint udllist<T>::array_sort(LT lt)
+{
+    if( length < 2 ) return 0;
+    T **values = new (std::nothrow) T *[length];
+    if( !values ) return 0;  // memory allocation failed
+
+    udllchunk<T> *c = head;
+    uint j = 0;
+    do
+    {   memcpy(values + j, c->value, c->count * sizeof(T *));
+        j += c->count;
+        c  = c->next;
+    } while( c != head );
+
+    uint comparisons = 0;
+    std::stable_sort(values, values + length,
+                     [&lt, &comparisons](T *a, T *b)
+                     { comparisons++; return lt(b, a); } );
+
+    j = 0;
+    do
+    {   memcpy(c->value, values + j, c->count * sizeof(T *));
+        j += c->count;
+        c  = c->next;
+    } while( c != head );
+
+    delete [] values;
+    return comparisons;
+} // template udllist<T>::array_sort()
+
+
+// Template : bool udllist<T>::operator==(const udllist<T> &a) const
+// Purpose  : test for identity of two lists, conserving order,
+//            by comparing their value pointers
+// Note     : identical() preforms same test using T::operator==()
+template <class T>
+bool udllist<T>::operator==(const udllist<T> &a) const
+{
+    if( length != a.length ) return false;
+    cudllit<T> j(a);
+    for(cudllit<T> i(*this); !i.finished(); ++i, ++j)
+        if( i() != j() ) return false;
+    return true;  // lists are identical
+}  // template udllist<T>::operator==()
+
+
+// Template : bool udllist<T>::identical(const udllist<T> &a) const
+// Purpose  : test for identity of two lists, conserving order,
+//            by comparing *value == *value with T::operator==()
+template <class T>
+bool udllist<T>::identical(const udllist<T> &a) const
+{
+    if( length != a.length ) return false;
+    cudllit<T> j(a);
+    for(cudllit<T> i(*this); !i.finished(); ++i, ++j)
+        if( !(*i() == *j()) ) return false;
+    return true;  // lists are identical
+}  // template udllist<T>::identical()
+
+
+// Template : bool udllist<T>::in_list(const T *a) const
+// Purpose  : report if the pointer 'a' is a value of the list
+template <class T>
+bool udllist<T>::in_list(const T *a) const
+{
+    if( !length ) return false;
+    const udllchunk<T> *c = head;
+    do
+    {   for(uint j = 0; j < c->count; j++)
+            if( c->value[j] == a ) return true;
+        c = c->next;
+    } while( c != head );
+    return false;  // 'a' wasn't found
+}  // template udllist<T>::in_list()
+
+
+// Template : T *udllist<T>::ref_in_list(const T &a)
+// Purpose  : find a value equal to 'a' using T::operator==()
+// Returns  : pointer to first equal value in *this
+//            0 if not found
+template <class T>
+T *udllist<T>::ref_in_list(const T &a) const
+{
+    for(cudllit<T> i(*this); !i.finished(); ++i)
+        if( *i() == a ) return i();
+
+    return 0;  // 'a' wasn't found
+} // template udllist<T>::ref_in_list()
+
+
+// Template : T *udllist<T>::match_in_list(const string& str)
+// Purpose  : find a match using T::matches(const string& str)
+// Returns  : pointer to first matched value in *this
+//            0 if not found
+template <class T>
+T *udllist<T>::match_in_list(const string& str) const
+{
+    for(cudllit<T> i(*this); !i.finished(); ++i)
+        if( i()->matches(str) ) return i();
+
+    return 0;  // match wasn't found
+} // template udllist<T>::match_in_list()
+
+
+// Template : T *udllist<T>::match_in_list(const string& str1, const string& str2)
+// Purpose  : find a match using T::matches(const string&, const string&)
+// Returns  : pointer to first matched value in *this
+//            0 if not found
+template <class T>
+T *udllist<T>::match_in_list(const string& str1, const string& str2) const
+{
+    for(cudllit<T> i(*this); !i.finished(); ++i)
+        if( i()->matches(str1, str2) ) return i();
+
+    return 0;  // match wasn't found
+} // template udllist<T>::match_in_list()
+
+
+// Template : T *udllist<T>::match_in_list(const int num)
+// Purpose  : find a match using T::matches(const int num)
+// Returns  : pointer to first matched value in *this
+//            0 if not found
+template <class T>
+T *udllist<T>::match_in_list(const int num) const
+{
+    for(cudllit<T> i(*this); !i.finished(); ++i)
+        if( i()->matches(num) ) return i();
+
+    return 0;  // match wasn't found
+} // template udllist<T>::match_in_list()
+
+
+// Template : T *udllist<T>::match_in_list(const uint num)
+// Purpose  : find a match using T::matches(const uint num)
+// Returns  : pointer to first matched value in *this
+//            0 if not found
+template <class T>
+T *udllist<T>::match_in_list(const uint num) const
+{
+    for(cudllit<T> i(*this); !i.finished(); ++i)
+        if( i()->matches(num) ) return i();
+
+    return 0;  // match wasn't found
+} // template udllist<T>::match_in_list()
+
+
+// Template : T *udllist<T>::match_in_list(const double num)
+// Purpose  : find a match using T::matches(const double& num)
+// Returns  : pointer to first matched value in *this
+//            0 if not found
+template <class T>
+T *udllist<T>::match_in_list(const double num) const
+{
+    for(cudllit<T> i(*this); !i.finished(); ++i)
+        if( i()->matches(num) ) return i();
+
+    return 0;  // match wasn't found
+} // template udllist<T>::match_in_list()
+
+
+// Template : T *udllist<T>::get_num(const uint num) const
+// Purpose  : find the num-th value, num is zero starting
+// Returns  : the value, 0 if num >= length
+template <class T>
+T *udllist<T>::get_num(const uint num) const
+{
+    if( num >= length ) return 0;
+    uint offset;
+    const udllchunk<T> *c = locate(num, offset);
+    return c->value[offset];
+} // template udllist<T>::get_num()
+
+
+// Template : uint udllit<T>::remove(void)
+// Purpose  : removes the value the iterator is pointing to,
+//            does NOT DELETE the T object
+// Returns  : new legnth of list, 0 if list is (now) empty
+// Notes    : iterator moves to the value AFTER the one removed,
+//            step_made is handled as in dllit<T>::remove(), so
+//            a loop removing values should skip its ++ after
+//            a remove, as in
+//            for(udllit<T> i(list); !i.done();)
+//              if( -something- ) i.remove(); else ++i;
+template <class T>
+uint udllit<T>::remove(void)
+{
+    if( !list.length || !chunk ) return 0;
+    bool resetting_head = at_start();
+    mark();
+    list.remove_at(chunk, offset);
+    if( i >= list.length ) i = 0;  // was the last value, now pointing at head
+    seat();
+    if( !resetting_head ) step_made = true;
+    return list.length;
+} // template udllit<T>::remove()
+
+
+// Template : uint udllit<T>::remove_delete(void)
+// Purpose  : removes the value the iterator is pointing to,
+//            and DELETES the T object
+// Returns  : new legnth of list, 0 if list is (now) empty
+// Notes    : same as remove()
+template <class T>
+uint udllit<T>::remove_delete(void)
+{
+    if( !list.length || !chunk ) return 0;
+    T *old = chunk->value[offset];
+    uint left = remove();
+    delete old;
+    return left;
+} // template udllit<T>::remove_delete()
+
+
+} // namespace blib
+
+// udll.cxx
@@ -0,0 +1,278 @@
+/*****************************************************************************/
+/*** Software: AMOS v0.01 (c)1998 All Rights Reserved by Bradley B. Custer ***/
+/*****************************************************************************/
+
+// File    : udll.h
+// Purpose : contains templates for an unrolled doublely-linked list ADT
+//           udllist keeps its value pointers packed into fixed size
+//           chunks, udllchunk, which are the links of the list
+//
+// Update Log -
+//
+// 20261017 - Begun, with the dllist methods and iterator protocol
+// 20261017 - the cursor is a dllcursor, so const positional access is thread safe
+
+
+#ifndef UNROLLED_DOUBLELY_LINKED_LIST_TEMPLATE
+#define UNROLLED_DOUBLELY_LINKED_LIST_TEMPLATE
+
+
+#include <string>
+#include "blib.h"    // blib defines
+#include "dllcursor.h" // the last-access cursor
+
+
+using std::string;
+
+
+namespace blib
+{
+
+
+// prototypes
+template <class T> struct udllchunk;
+template <class T> class  udllist;
+template <class T> class  udllit;
+template <class T> class  cudllit;
+
+
+// number of value pointers held by each udllchunk, a chunk is
+//  then 8*UDLL_CHUNK_SIZE + 24 bytes on a 64 bit build
+#define  UDLL_CHUNK_SIZE  32
+
+
+// Template : struct udllchunk
+// Purpose  : one link of a udllist, holding up to UDLL_CHUNK_SIZE
+//            value pointers packed into value[0..count-1]
+template <class T> struct udllchunk
+{
+    T             *value[UDLL_CHUNK_SIZE];  // values of this chunk, in list order
+    uint           count;                   // number of value[] in use
+    udllchunk<T>  *next;
+    udllchunk<T>  *prior;
+
+    udllchunk(void) : count(0), next(0), prior(0) {}
+}; // template struct udllchunk
+
+
+// Template: class udllist
+// Purpose : unrolled doublely-linked list of T pointers, with the
+//           method names and iterator protocol of dllist<T>
+//           the chunks form a ring, just like dllist's nodes, but
+//           each holds many values, so a value costs about 8 bytes
+//           instead of a 24 byte node and its malloc overhead, and
+//           iteration reads pointers that sit next to each other
+// Warning : just like dllist, the values pointed to are NOT DELETED
+//           when the list is purged, deleted, or a value removed,
+//           use free_all() or the *_delete() methods for that
+// Note    : positional access walks chunk by chunk, from the nearest
+//           of the head, the last chunk or the chunk last used
+//           that chunk is kept in a dllcursor, as dllist keeps its node,
+//           so several threads may read one list by position at once
+template <class T> class udllist
+{
+    private:
+        udllchunk<T> *head;               // first chunk
+        uint length;                      // length of list
+        mutable dllcursor< udllchunk<T> > cursor;  // chunk found by last positional access, and the position of its value[0]
+
+        friend class udllit<T>;
+        friend class cudllit<T>;
+
+        udllchunk<T> *locate(uint, uint &) const;     // find chunk holding i-th value (i < length), and its offset
+        udllchunk<T> *new_chunk_after(udllchunk<T> *);// link an empty chunk after arg, or as the only chunk if 0
+        void free_chunk(udllchunk<T> *);              // unlink and delete an emptied chunk
+        uint insert_at(udllchunk<T> *, uint, T *);    // insert value at chunk offset, splitting a full chunk
+        T   *remove_at(udllchunk<T> *, uint);         // remove value at chunk offset, merging sparse chunks
+
+        template <class LT> uint array_sort(LT);      // stable greatest-to-least sort by a value less-than
+
+    public:
+        typedef cudllit<T> citerator;   // const iterator type, for templates taking any blib list
+
+        // constructors
+        udllist() : head(0), length(0) {}
+        udllist(const udllist<T> &a) : head(0), length(0)
+            { operator=(a); }
+        // destructor
+        ~udllist() { purge(); }  // this only frees the chunks, does not delete values pointed to
+
+        // mutators
+        void operator=(const udllist<T> &);   // assign *this to a copy of arguement's value pointers
+        void operator+=(const udllist<T> &);  // add copy of argument's value pointers to end of *this
+        void copy(const udllist<T> &);        // purge() *this, copy instances from arg, new T objects values built
+        void append_and_purge(udllist<T> &);  // places arguement's chunks onto end of *this, leaving arguement purge()d
+        void add_list(const udllist<T> &a) { *this += a; }
+        uint push(T *);                       // adds new value pointer at beginning of list, does NOT build a new T
+        uint add(T *);                        // adds new value pointer at end of list, does NOT build a new T
+        uint add_copy(const T&);              // adds new value pointer and builds a new T it points to, using T::operator=()
+        uint add_num(T *, uint);              // add a value pointer in i-th position, does NOT build a new T
+        bool pop(void);                       // removes first value from list, does not delete T objects
+        bool pop_delete(void);                // removes first value from list, and DELETES T object it points to
+        bool remove(const T*);                // removes first oldvalue from list comparing pointer values, does not delete T objects
+        bool remove_delete(T*);               // removes first oldvalue from list comparing pointer values, DOES DELETE it
+        bool remove(const T&);                // removes first oldvalue from list comparing with T::operator==(), does not delete it
+        bool remove_delete(const T&);         // removes first oldvalue from list comparing with T::operator==(), DOES DELETE it
+        bool remove_last(void);               // removes last value from list, does not delete T objects
+        bool remove_last_delete(void);        // removes last value from list, and DELETES T object it points to
+        bool remove_num(uint);                // removes i-th value from list, does not delete T objects
+        bool remove_num_delete(uint);         // removes i-th value from list, and DELETES T object it points to
+        void purge(void);                     // removes every value from the list, does not delete T objects
+        void free_all(void);                  // deletes every value in the list, DELETES the T objects
+        uint sort(void);                      // sorts the list greast-to-least with T::operator<(const T&)
+        uint sort_dll(void);                  // sorts the list greast-to-least with T::dll_lessthan(const T*)
+        uint sort(bool (*)(const T*, const T*));
+
+        // inspectors
+        bool identical(const udllist<T>&) const;   // identity by *value == *value
+        bool operator==(const udllist<T>&) const;  // identity by value  == value
+        bool operator!=(const udllist<T>& a) const // identity by value  != value
+            { return !(*this == a); }
+        bool in_list(const T*) const;              // report if argument is in list, comparing pointer values
+        T* ref_in_list(const T&) const;            // return 1st match to argument in list, comparing with T::operator==()
+        T* match_in_list(const string&) const;                 // return 1st match to string key in list, comparing with "bool T::matches(const string&) const"
+        T* match_in_list(const string&, const string&) const;  // return 1st match to string keys in list, comparing with "bool T::matches(const string&, const string&) const"
+        T* match_in_list(const int) const;                     // report if a match to int key is in list, comparing with T::matches(const int)
+        T* match_in_list(const uint) const;                    // report if a match to uint key is in list, comparing with T::matches(const uint)
+        T* match_in_list(const double) const;                  // return 1st match to double key in list, comparing with "bool T::matches(const double&) const"
+        T& operator[](uint i) const                // return reference to ith value
+            { return *get_num(i); }
+        T* get_num(const uint) const;              // return pointer to ith value, 0 if past end
+        T* first(void) const                       // return first value
+            { if( length ) return head->value[0]; else return 0; }
+        T* last(void) const                        // return last value
+            { if( length ) return head->prior->value[head->prior->count - 1]; else return 0; }
+        bool empty(void) const                     // report if list is empty
+            { if( length ) return false; else return true; }
+        uint size(void) const { return length; }    // report size of list
+}; // template class udllist
+
+
+// Template : class udllit
+// Purpose  : iterator class for udllist, used just as dllit
+//            for(udllit<T> i(list); !i.finished(); ++i) ;
+template <class T> class udllit
+{
+    private:
+        udllchunk<T> *chunk;      // chunk of current iteration
+        uint         offset;      // position in chunk
+        udllist<T>   &list;       // list being iterated
+        bool         step_made;   // flags whether iteration has begun
+        uint         i;           // maintains iterative position
+
+        void seat(void)           // point chunk & offset at position i
+            { if( list.length ) chunk = list.locate(i, offset); else { chunk = 0; offset = 0; } }
+        void mark(void)           // hand the list our chunk as its cursor, so an edit here finds it at once
+            { if( chunk ) list.cursor.set(chunk, i - offset); }
+
+    public:
+        // constructor
+        udllit(udllist<T> &L) : chunk(L.head), offset(0), list(L), step_made(false), i(0) {}
+        udllit(udllist<T> &L, const uint &s)
+            : chunk(L.head), offset(0), list(L), step_made(false), i(0)
+            { start_at(s); }
+
+        // mutators
+        void start(void)           // start iteration over again
+            { chunk = list.head; offset = 0; step_made = false; i = 0; }
+        void start_at(const uint& s)  // same as start() then s ++'s, positions past the end wrap around
+            { start(); if( !list.length || !s ) return;
+              i = s % list.length; seat(); step_made = true; }
+        T *operator++(void)        // increment element being pointed to
+            { step_made = true; if( !chunk ) return 0;
+              if( ++offset >= chunk->count ) { chunk = chunk->next; offset = 0; }
+              if( chunk == list.head && !offset ) i = 0; else i++;
+              return chunk->value[offset]; }
+        T *operator--(void)        // decrement element being pointed to
+            { step_made = true; if( !chunk ) return 0;
+              if( offset ) offset--; else { chunk = chunk->prior; offset = chunk->count - 1; }
+              if( i ) i--; else i = list.length - 1;
+              return chunk->value[offset]; }
+        T *operator=(T *a)         // assign value of element pointed to
+            { if( chunk ) chunk->value[offset] = a;
+              else { list.add(a); start(); } return a; }
+        uint add_before(T *a)      // adds value before iterator position, iterator stays on the same value
+            { mark(); uint l = list.add_num(a, i); if( l ) i++; seat(); return l; }
+        uint add_after(T *a)       // adds value after iterator position, iterator stays on the same value
+            { mark(); uint l = list.add_num(a, i + 1); seat(); return l; }
+        uint remove(void);         // remove current iteration from list, does NOT DELETE value object
+        uint remove_delete(void);  // remove current iteration from list, WILL DELETE value object
+
+        // inspectors
+        uint num(void) const       // return iteration position
+            { return i; }
+        T *operator()(void) const  // inspect value interator is pointing to
+            { if( chunk ) return chunk->value[offset]; return 0; }
+        bool at_start(void) const  // is iterator pointing to first element?
+            { if( list.length ) return chunk == list.head && !offset; return false; }
+        bool at_end(void) const    // is iterator pointing to last element?
+            { if( list.length ) return chunk == list.head->prior && offset + 1 == chunk->count; return true; }
+        bool finished(void) const  // has a full list iteration occured ?
+            { if( list.length )
+              { if( step_made ) return at_start(); else return false; }
+              return true; }
+        bool done(void) const      // second name for finished()
+            { return finished(); }
+}; // template class udllit
+
+
+// Template : class cudllit
+// Purpose  : const iterator class for udllist, used just as cdllit
+template <class T> class cudllit
+{
+    private:
+        const udllchunk<T> *chunk;      // chunk of current iteration
+        uint               offset;      // position in chunk
+        const udllist<T>   &list;       // list being iterated
+        bool               step_made;   // flags whether iteration has begun
+        uint               i;           // maintains iterative position
+
+    public:
+        // constructor
+        cudllit(const udllist<T> &L) : chunk(L.head), offset(0), list(L), step_made(false), i(0) {}
+        cudllit(const udllist<T> &L, const uint &s)
+            : chunk(L.head), offset(0), list(L), step_made(false), i(0)
+            { start_at(s); }
+
+        // mutators
+        void start(void)           // start iteration over again
+            { chunk = list.head; offset = 0; step_made = false; i = 0; }
+        void start_at(const uint& s)  // same as start() then s ++'s, positions past the end wrap around
+            { start(); if( !list.length || !s ) return;
+              i = s % list.length; chunk = list.locate(i, offset); step_made = true; }
+        T *operator++(void)        // increment element being pointed to
+            { step_made = true; if( !chunk ) return 0;
+              if( ++offset >= chunk->count ) { chunk = chunk->next; offset = 0; }
+              if( chunk == list.head && !offset ) i = 0; else i++;
+              return chunk->value[offset]; }
+        T *operator--(void)        // decrement element being pointed to
+            { step_made = true; if( !chunk ) return 0;
+              if( offset ) offset--; else { chunk = chunk->prior; offset = chunk->count - 1; }
+              if( i ) i--; else i = list.length - 1;
+              return chunk->value[offset]; }
+
+        // inspectors
+        uint num(void) const       // return iteration position
+            { return i; }
+        T *operator()(void) const  // inspect value interator is pointing to
+            { if( chunk ) return chunk->value[offset]; return 0; }
+        bool at_start(void) const  // is iterator pointing to first element?
+            { if( list.length ) return chunk == list.head && !offset; return false; }
+        bool at_end(void) const    // is iterator pointing to last element?
+            { if( list.length ) return chunk == list.head->prior && offset + 1 == chunk->count; return true; }
+        bool finished(void) const  // has a full list iteration occured ?
+            { if( list.length )
+              { if( step_made ) return at_start(); else return false; }
+              return true; }
+        bool done(void) const      // second name for finished()
+            { return finished(); }
+}; // template class cudllit
+
+
+} // namespace blib
+
+#include "udll.cxx"   // included b/c udllist is a set of template classes, not compilable itself
+
+#endif // UNROLLED_DOUBLELY_LINKED_LIST_TEMPLATE
+
+// udll.h